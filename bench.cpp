@@ -0,0 +1,386 @@
+//////////////////////////////////////////////////////////////////////////////
+// /home/doug/CLionProjects/semigraphics/bench.cpp   2026/10/17 14:30 dwg - //
+// Copyright (c) 2021-2026 Douglas Wade Goodall. All Rights Reserved.       //
+//////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fcntl.h>
+#include <string>
+#include <string_view>
+#include <unistd.h>
+#include <vector>
+
+#include "crtbind.h"
+#include "renderstats.h"
+#include "semigraphics.h"
+#include "surface.h"
+#include "table.h"
+#include "themed.h"
+#include "window.h"
+
+crtbind * gpCrt;
+semigraphics * gpSemiGr;
+
+/**
+ * @brief Output of the frames produced while benchmarking.
+ *
+ * By default an fdsink on /dev/null, so syscalls are real and counted;
+ * with --null a nullsink, which leaves out the cost of the syscalls.
+ */
+static crtsink * gpSink;
+
+/**
+ * @brief Number of timed repetitions per benchmark; the median is reported.
+ */
+static constexpr int REPEATS = 5;
+
+/**
+ * @brief Runs one benchmark and prints a line of results.
+ *
+ * fn(iOps) performs iOps operations. It runs once untimed to warm caches,
+ * then REPEATS times; ns/op is the median, bytes and syscalls per op are
+ * taken over all timed runs. gpCrt is flushed after every run. With
+ * --stats the renderstats totals of the benchmark follow on a second line.
+ *
+ * @param ssFilter Only benchmarks whose name contains this run.
+ * @param ssName The benchmark name.
+ * @param iOps Operations per run.
+ * @param fn The operations.
+ */
+template <class F>
+static void bench(std::string_view ssFilter, std::string_view ssName, size_t iOps, F && fn) {
+    if (ssName.find(ssFilter) == std::string_view::npos) {
+        return;
+    }
+    fn(iOps);
+    gpCrt->crtflush();
+    uint64_t iBytes0 = gpSink->get_bytes();
+    uint64_t iCalls0 = gpSink->get_writes();
+    std::array<double,REPEATS> ns;
+    for (double & d : ns) {
+        auto t0 = std::chrono::steady_clock::now();
+        fn(iOps);
+        gpCrt->crtflush();
+        d = std::chrono::duration<double,std::nano>(std::chrono::steady_clock::now() - t0).count() / iOps;
+    }
+    std::sort(ns.begin(),ns.end());
+    double dOps = static_cast<double>(iOps) * REPEATS;
+    std::printf("%-32s %10zu %12.1f %12.1f %12.4f\n",std::string(ssName).c_str(),iOps,ns[REPEATS / 2],
+                (gpSink->get_bytes() - iBytes0) / dOps,(gpSink->get_writes() - iCalls0) / dOps);
+    if (renderstats::enabled()) {
+        std::printf("    %s\n",renderstats::format(renderstats::total()).c_str());
+        renderstats::enable(true);
+    }
+    std::fflush(stdout);
+}
+
+/**
+ * @brief Builds a deterministic row of roughly iLen bytes of mixed text.
+ */
+static std::string sample_row(size_t i, size_t iLen) {
+    static constexpr std::string_view words[] = {
+        "GET","/api/v1/items","200","OK","latency","ms","user","session","cache","miss"};
+    std::string ss = std::to_string(i);
+    while (ss.size() < iLen) {
+        ss += ' ';
+        ss += words[(i + ss.size()) % std::size(words)];
+    }
+    ss.resize(iLen);
+    return ss;
+}
+
+/**
+ * @brief Fills a window with iRows sample rows.
+ */
+static void fill(window & w, size_t iRows) {
+    w.set_title("bench");
+    for (size_t i = 0; i < iRows; i++) {
+        w.add_row(sample_row(i,60));
+    }
+}
+
+int main(int argc, char * argv[])
+{
+    std::string ssFilter;
+    bool bNull = false;
+    for (int i = 1; i < argc; i++) {
+        std::string_view ssArg(argv[i]);
+        if (ssArg == "--null") {
+            bNull = true;
+        } else if (ssArg == "--stats") {
+            renderstats::enable(true);
+        } else if (ssArg == "--trace" && i + 1 < argc) {
+            renderstats::trace_open(argv[++i]);
+        } else {
+            ssFilter = ssArg;
+        }
+    }
+    nullsink null;
+    int fdNull = ::open("/dev/null",O_WRONLY | O_CLOEXEC);
+    fdsink devnull(fdNull);
+    gpSink = bNull ? static_cast<crtsink *>(&null) : &devnull;
+    gpCrt = new crtbind(gpSink);
+    gpCrt->crtsetsize(50,200);
+    gpSemiGr = new semigraphics();
+    gpSemiGr->set_theme(&THEME_ROUNDED);
+
+    std::printf("%-32s %10s %12s %12s %12s\n","benchmark","ops","ns/op","bytes/op","syscalls/op");
+
+    // Box primitives, streamed; one flush per run of 1000 rows.
+    for (int width : {10,80,200}) {
+        std::string ssText = sample_row(7,width - 3);
+        std::string ssWidth = std::to_string(width);
+        bench(ssFilter,"topline/" + ssWidth,1000,[&](size_t n) {
+            for (size_t i = 0; i < n; i++) {
+                gpSemiGr->topline(1,1,width,0);
+            }
+        });
+        bench(ssFilter,"middleline/" + ssWidth,1000,[&](size_t n) {
+            for (size_t i = 0; i < n; i++) {
+                gpSemiGr->middleline(1,1,width,0,ssText);
+            }
+        });
+        bench(ssFilter,"endline/" + ssWidth,1000,[&](size_t n) {
+            for (size_t i = 0; i < n; i++) {
+                gpSemiGr->endline(1,1,width,0);
+            }
+        });
+    }
+
+    // The same row with the theme fixed at compile time.
+    gpSemiGr->set_theme(&THEME_DOUBLE);
+    bench(ssFilter,"topline/80-dynamic",1000,[&](size_t n) {
+        for (size_t i = 0; i < n; i++) {
+            gpSemiGr->topline(1,1,80,0);
+        }
+    });
+    bench(ssFilter,"topline/80-themed",1000,[&](size_t n) {
+        for (size_t i = 0; i < n; i++) {
+            themed_semigraphics<theme_double>::topline<80>(1,1);
+        }
+    });
+    gpSemiGr->set_theme(&THEME_ROUNDED);
+
+    // Row ingestion at scale.
+    {
+        std::vector<std::string> rows;
+        for (size_t i = 0; i < 4096; i++) {
+            rows.push_back(sample_row(i,60));
+        }
+        bench(ssFilter,"add_row/1M",1000000,[&](size_t n) {
+            window w;
+            for (size_t i = 0; i < n; i++) {
+                w.add_row(rows[i & 4095]);
+            }
+        });
+        window pane;
+        for (size_t i = 0; i < 100000; i++) {
+            pane.add_row(rows[i & 4095]);
+        }
+        bench(ssFilter,"update_row/100k",1000000,[&](size_t n) {
+            for (size_t i = 0; i < n; i++) {
+                pane.update_row((i * 7919) % 100000,rows[(i * 31) & 4095]);
+            }
+        });
+    }
+
+    // Whole windows, one frame (and one flush) per op.
+    {
+        window small;
+        window medium;
+        window huge;
+        fill(small,5);
+        fill(medium,50);
+        fill(huge,1000000);
+        huge.set_viewport(45);
+        bench(ssFilter,"render/small",10000,[&](size_t n) {
+            for (size_t i = 0; i < n; i++) {
+                small.render();
+                gpCrt->crtflush();
+            }
+        });
+        bench(ssFilter,"render/medium",2000,[&](size_t n) {
+            for (size_t i = 0; i < n; i++) {
+                medium.render();
+                gpCrt->crtflush();
+            }
+        });
+        bench(ssFilter,"render/huge-viewport",2000,[&](size_t n) {
+            for (size_t i = 0; i < n; i++) {
+                huge.scroll_by((i & 1) ? 45 : -45);
+                huge.render();
+                gpCrt->crtflush();
+            }
+        });
+        huge.set_wrap(WRAP_WORD);
+        bench(ssFilter,"render/huge-resize",2000,[&](size_t n) {
+            for (size_t i = 0; i < n; i++) {
+                huge.set_max_cols((i & 1) ? 50 : 70);
+                huge.render();
+                gpCrt->crtflush();
+            }
+        });
+        huge.set_wrap(WRAP_NONE);
+        window log;
+        fill(log,40);
+        log.set_viewport(20);
+        log.set_scroll_accel(true);
+        bench(ssFilter,"render/scroll-accel",10000,[&](size_t n) {
+            for (size_t i = 0; i < n; i++) {
+                log.add_row(sample_row(i,60));
+                log.render();
+                gpCrt->crtflush();
+            }
+        });
+    }
+
+    // A 100k-row table: numeric cell updates alone, then with one frame
+    // of a 30-row viewport per op. Shrinking the widest cell costs a
+    // column rescan on the next frame.
+    {
+        table t;
+        t.add_column("Host");
+        t.add_column("Requests",COLUMN_INT);
+        t.add_column("Latency ms",COLUMN_REAL,3);
+        t.add_column("Status");
+        for (size_t i = 0; i < 100000; i++) {
+            t.add_row();
+            t.set(i,0,"host-" + std::to_string(i));
+            t.set_int(i,1,static_cast<int64_t>(i * 7919 % 1000003));
+            t.set_real(i,2,(i % 977) * 0.25);
+            t.set(i,3,(i & 7) ? "ok" : "degraded");
+        }
+        t.set_viewport(30);
+        bench(ssFilter,"table/update",1000000,[&](size_t n) {
+            for (size_t i = 0; i < n; i++) {
+                size_t iRow = (i * 7919) % 100000;
+                t.set_int(iRow,1,static_cast<int64_t>(i * 131 % 1000003));
+                t.set_real(iRow,2,(i % 977) * 0.25);
+            }
+        });
+        bench(ssFilter,"table/update-render",10000,[&](size_t n) {
+            for (size_t i = 0; i < n; i++) {
+                size_t iRow = (i * 7919) % 100000;
+                t.set_int(iRow,1,static_cast<int64_t>(i * 131 % 1000003));
+                t.set_real(iRow,2,(i % 977) * 0.25);
+                t.scroll_to(iRow);
+                t.render();
+                gpCrt->crtflush();
+            }
+        });
+    }
+
+    // A medium window through the diff presenter: full repaints, then
+    // frames where one new row scrolls the viewport.
+    {
+        surface s(50,200);
+        window w;
+        fill(w,40);
+        w.set_viewport(40);
+        gpSemiGr->set_surface(&s);
+        bench(ssFilter,"present/full",500,[&](size_t n) {
+            for (size_t i = 0; i < n; i++) {
+                s.invalidate();
+                s.clear();
+                w.render();
+                s.present();
+                gpCrt->crtflush();
+            }
+        });
+        bench(ssFilter,"present/scroll",5000,[&](size_t n) {
+            for (size_t i = 0; i < n; i++) {
+                w.add_row(sample_row(i,60));
+                s.clear();
+                w.render();
+                s.present();
+                gpCrt->crtflush();
+            }
+        });
+        gpSemiGr->set_surface(nullptr);
+    }
+
+    // Escape sequence emission.
+    bench(ssFilter,"crtstyle/delta",100000,[&](size_t n) {
+        for (size_t i = 0; i < n; i++) {
+            gpCrt->crtstyle((i & 1) ? MODE_BOLD : MODE_RESET,static_cast<FG_COLORS_T>(FG_BLACK + (i & 7)),BG_BLACK);
+        }
+    });
+    bench(ssFilter,"crtstyle/full",100000,[&](size_t n) {
+        for (size_t i = 0; i < n; i++) {
+            gpCrt->crtinvalidate();
+            gpCrt->crtstyle(MODE_BOLD,static_cast<FG_COLORS_T>(FG_BLACK + (i & 7)),BG_BLUE);
+        }
+    });
+    bench(ssFilter,"crtstyle_rgb/truecolor",100000,[&](size_t n) {
+        gpCrt->crtsetcaps(CAP_256 | CAP_RGB);
+        for (size_t i = 0; i < n; i++) {
+            gpCrt->crtstyle_rgb(MODE_RESET,static_cast<uint32_t>(i * 2654435761u) & 0xFFFFFF,0x000000);
+        }
+    });
+    bench(ssFilter,"crtstyle_rgb/quantized",100000,[&](size_t n) {
+        gpCrt->crtsetcaps(CAP_256);
+        for (size_t i = 0; i < n; i++) {
+            gpCrt->crtstyle_rgb(MODE_RESET,static_cast<uint32_t>(i * 2654435761u) & 0xFFFFFF,0x000000);
+        }
+    });
+    gpCrt->crtsetcaps(0);
+    bench(ssFilter,"crtlc/absolute",100000,[&](size_t n) {
+        for (size_t i = 0; i < n; i++) {
+            gpCrt->crtinvalidate();
+            gpCrt->crtlc(1 + (i * 7) % 50,1 + (i * 13) % 200);
+        }
+    });
+    bench(ssFilter,"crtlc/planned",100000,[&](size_t n) {
+        for (size_t i = 0; i < n; i++) {
+            gpCrt->crtlc(1 + (i * 7) % 50,1 + (i * 13) % 200);
+        }
+    });
+
+    // Input decoding, and flushing with input attached.
+    {
+        static constexpr std::string_view s_keys =
+            "a\xC3\xA9\x1B[A\x1B[1;5C\x1B[3~\x1BOP\x1B[<0;10;5M\r";    // 8 keys
+        crtinput in;
+        std::string ssInput;
+        bench(ssFilter,"input/decode",1000000,[&](size_t n) {
+            ssInput.clear();
+            for (size_t i = 0; i < n; i += 8) {
+                ssInput.append(s_keys);
+            }
+            crtkey key;
+            for (size_t i = 0; i < ssInput.size(); i += 1024) {
+                in.feed(std::string_view(ssInput).substr(i,1024));
+                while (in.pop(key)) {
+                }
+            }
+        });
+        std::string ssBig(1 << 20,'#');
+        bench(ssFilter,"flush/1M",100,[&](size_t n) {
+            for (size_t i = 0; i < n; i++) {
+                gpCrt->crtputs(ssBig);
+                gpCrt->crtflush();
+            }
+        });
+        int fdPipe[2];
+        if (::pipe(fdPipe) == 0) {
+            gpCrt->crtraw(0,fdPipe[0]);
+            bench(ssFilter,"flush/1M-input",100,[&](size_t n) {
+                for (size_t i = 0; i < n; i++) {
+                    gpCrt->crtputs(ssBig);
+                    gpCrt->crtflush();
+                }
+            });
+            gpCrt->crtcooked();
+            ::close(fdPipe[0]);
+            ::close(fdPipe[1]);
+        }
+    }
+
+    renderstats::trace_close();
+    ::close(fdNull);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,144 @@
+/////////////////////////////////////////////////////////////////////////////////
+// /home/doug/CLionProjects/semigraphics/compositor.cpp 2026/10/17 13:05 dwg - //
+// Copyright (c) 2021-2026 Douglas Wade Goodall. All Rights Reserved.          //
+/////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <vector>
+
+#include "crtbind.h"
+#include "semigraphics.h"
+#include "compositor.h"
+#include "renderstats.h"
+
+extern semigraphics * gpSemiGr;
+
+/**
+ * @brief Constructs a compositor with no windows.
+ *
+ * @param pSurface The target surface.
+ */
+compositor::compositor(surface * pSurface) {
+    m_pSurface = pSurface;
+    m_iDrawn = 0;
+    m_iCulled = 0;
+}
+
+/**
+ * @brief Inserts a layer ahead of every layer at or below its z, keeping
+ * m_layers in top-down order.
+ *
+ * @param pWin The window.
+ * @param z Its stacking level.
+ */
+void compositor::insert(window * pWin, int z) {
+    auto it = std::find_if(m_layers.begin(),m_layers.end(),
+                           [z](const layer & l) { return l.z <= z; });
+    m_layers.insert(it,layer{pWin,z});
+}
+
+/**
+ * @brief Adds a window.
+ *
+ * @param pWin The window.
+ * @param z Its stacking level.
+ */
+void compositor::add(window * pWin, int z) {
+    remove(pWin);
+    insert(pWin,z);
+}
+
+/**
+ * @brief Removes a window; unknown windows are ignored.
+ *
+ * @param pWin The window.
+ */
+void compositor::remove(window * pWin) {
+    std::erase_if(m_layers,[pWin](const layer & l) { return l.pWin == pWin; });
+}
+
+/**
+ * @brief Changes a window's stacking level.
+ *
+ * @param pWin The window.
+ * @param z The new level.
+ */
+void compositor::set_z(window * pWin, int z) {
+    add(pWin,z);
+}
+
+/**
+ * @brief Moves a window above every other window.
+ *
+ * @param pWin The window.
+ */
+void compositor::raise(window * pWin) {
+    int z = m_layers.empty() ? 0 : m_layers.front().z;
+    add(pWin,z);
+}
+
+/**
+ * @brief Draws the windows into the surface from the top of the z-order down.
+ *
+ * Each window's queued rows are drained first so that its frame size is
+ * final. A window whose frame has no uncovered cell on the surface is
+ * culled; otherwise it is rendered and its frame covered. The semigraphics
+ * primitives skip rows that are already fully covered, and the surface
+ * drops writes to covered cells, so hidden cells are never drawn.
+ */
+void compositor::compose() {
+    renderspan span("compositor::compose",PHASE_LAYOUT);
+    surface * pPrevious = gpSemiGr->get_surface();
+    gpSemiGr->set_surface(m_pSurface);
+    m_pSurface->clear();
+    m_pSurface->uncover();
+    m_iDrawn = 0;
+    m_iCulled = 0;
+    for (const layer & l : m_layers) {
+        window * pWin = l.pWin;
+        pWin->drain();
+        int iLine = pWin->get_y() + 1;
+        int iCol = pWin->get_x() + 1;
+        int iLines = pWin->get_frame_lines();
+        int iCols = pWin->get_frame_cols();
+        if (!m_pSurface->visible(iLine,iCol,iLines,iCols)) {
+            m_iCulled++;
+            continue;
+        }
+        pWin->render();
+        m_pSurface->cover(iLine,iCol,iLines,iCols);
+        m_iDrawn++;
+    }
+    m_pSurface->uncover();
+    gpSemiGr->set_surface(pPrevious);
+}
+
+/**
+ * @brief Composes the windows and presents the changed cells.
+ */
+void compositor::present() {
+    compose();
+    m_pSurface->present();
+}
+
+/**
+ * @brief Retrieves the number of windows drawn by the last compose().
+ *
+ * @return The drawn count.
+ */
+int compositor::get_drawn() {
+    return m_iDrawn;
+}
+
+/**
+ * @brief Retrieves the number of windows skipped by the last compose().
+ *
+ * @return The culled count.
+ */
+int compositor::get_culled() {
+    return m_iCulled;
+}
+
+//////////////////////////
+// eof - compositor.cpp //
+//////////////////////////
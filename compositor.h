@@ -0,0 +1,111 @@
+///////////////////////////////////////////////////////////////////////////////
+// /home/doug/CLionProjects/semigraphics/compositor.h 2026/10/17 13:05 dwg - //
+// Copyright (c) 2021-2026 Douglas Wade Goodall. All Rights Reserved.        //
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef COMPOSITOR_H
+#define COMPOSITOR_H
+
+#include <vector>
+
+#include "surface.h"
+#include "window.h"
+
+/**
+ * @class compositor
+ * @brief Stacks windows at their positions on one surface.
+ *
+ * Windows are kept sorted from the top of the z-order down and drawn in
+ * that order. After each window is drawn its frame is covered on the
+ * surface (see surface::cover()), so lower windows cannot overwrite it.
+ * A window with no uncovered cell on screen is skipped without rendering,
+ * and inside a partly hidden window the fully hidden rows are skipped too.
+ * Drawing cost therefore follows the visible cells, not the number of
+ * windows or how much they overlap. Everything is clipped to the surface.
+ */
+class compositor {
+    /**
+     * @brief One window and its place in the z-order.
+     */
+    struct layer {
+        window * pWin;
+        int z;
+    };
+
+    /**
+     * @brief The surface the windows are drawn into.
+     */
+    surface * m_pSurface;
+    /**
+     * @brief Layers sorted by descending z; among equal z the most recently
+     * added or raised comes first.
+     */
+    std::vector<layer> m_layers;
+    /**
+     * @brief Windows drawn by the last compose().
+     */
+    int m_iDrawn;
+    /**
+     * @brief Windows skipped by the last compose() as hidden or off screen.
+     */
+    int m_iCulled;
+
+    /**
+     * @brief Inserts a layer ahead of every layer at or below its z.
+     */
+    void insert(window * pWin,int z);
+
+public:
+    /**
+     * @brief Constructs a compositor that draws into a surface.
+     *
+     * @param pSurface The target surface; it is referenced, not owned.
+     */
+    compositor(surface * pSurface);
+    /**
+     * @brief Adds a window, on top of any window with the same z.
+     *
+     * @param pWin The window; it is referenced, not owned.
+     * @param z Stacking level; higher levels are drawn over lower ones.
+     */
+    void add(window * pWin,int z = 0);
+    /**
+     * @brief Removes a window.
+     *
+     * @param pWin The window to remove.
+     */
+    void remove(window * pWin);
+    /**
+     * @brief Changes a window's stacking level, placing it on top of that level.
+     *
+     * @param pWin The window.
+     * @param z The new level.
+     */
+    void set_z(window * pWin,int z);
+    /**
+     * @brief Moves a window above every other window.
+     *
+     * @param pWin The window.
+     */
+    void raise(window * pWin);
+    /**
+     * @brief Draws every visible window into the surface, top-down.
+     */
+    void compose();
+    /**
+     * @brief Composes and then presents the surface.
+     *
+     * As with surface::present(), the caller decides when to crtflush().
+     */
+    void present();
+    /**
+     * @brief Retrieves the number of windows drawn by the last compose().
+     */
+    int get_drawn();
+    /**
+     * @brief Retrieves the number of windows skipped by the last compose().
+     */
+    int get_culled();
+};
+
+#endif //COMPOSITOR_H
@@ -3,8 +3,303 @@
 // Copyright (c) 2021-2025 Douglas Wade Goodall. All Rights Reserved.       //
 //////////////////////////////////////////////////////////////////////////////
 
-#include "std.h"
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cerrno>
+#include <cstring>
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
 #include "crtbind.h"
+#include "renderstats.h"
+#include "utf8width.h"
+
+/**
+ * @brief A short escape sequence or SGR parameter stored inline.
+ */
+struct sgrseq {
+    char    bytes[15];
+    uint8_t len;
+};
+
+/**
+ * @brief Number of MODE_T slots covered by the SGR tables (codes 0 to 9).
+ */
+static constexpr int SGR_MODES = 10;
+
+/**
+ * @brief SGR parameter that switches each mode on, indexed by MODE_T.
+ */
+static constexpr std::string_view s_sgrOn[SGR_MODES] = {
+    "0", "1", "2", "3", "4", "5", "6", "7", "8", "9"
+};
+
+/**
+ * @brief SGR parameter that switches each mode off again, indexed by MODE_T.
+ *
+ * Bold and dim share 22; each of the others has its own cancel code.
+ */
+static constexpr std::string_view s_sgrOff[SGR_MODES] = {
+    "", "22", "22", "23", "24", "25", "25", "27", "28", "29"
+};
+
+/**
+ * @brief SGR parameters for the foreground colors, indexed by fg - FG_BLACK.
+ */
+static constexpr std::string_view s_sgrFg[8] = {
+    "30", "31", "32", "33", "34", "35", "36", "37"
+};
+
+/**
+ * @brief SGR parameters for the background colors, indexed by bg - BG_BLACK.
+ */
+static constexpr std::string_view s_sgrBg[8] = {
+    "40", "41", "42", "43", "44", "45", "46", "47"
+};
+
+/**
+ * @brief Appends a ';'-separated parameter to an SGR sequence under construction.
+ *
+ * @param seq The sequence being built; it must already hold the CSI prefix.
+ * @param ssParam The parameter text.
+ * @param bFirst True for the first parameter, which takes no separator.
+ */
+static constexpr void sgr_param(sgrseq & seq, std::string_view ssParam, bool bFirst) {
+    if (!bFirst) {
+        seq.bytes[seq.len++] = ';';
+    }
+    for (char ch : ssParam) {
+        seq.bytes[seq.len++] = ch;
+    }
+}
+
+/**
+ * @brief Full "reset, then set" sequences for every mode/fg/bg combination.
+ *
+ * Built at compile time; used whenever the terminal state is unknown.
+ * Index is (mode * 8 + fg - FG_BLACK) * 8 + bg - BG_BLACK.
+ */
+static constexpr auto s_sgrFull = [] {
+    std::array<sgrseq,SGR_MODES * 8 * 8> table{};
+    for (int iMode = 0; iMode < SGR_MODES; iMode++) {
+        for (int iFg = 0; iFg < 8; iFg++) {
+            for (int iBg = 0; iBg < 8; iBg++) {
+                sgrseq & seq = table[(iMode * 8 + iFg) * 8 + iBg];
+                seq.bytes[seq.len++] = '\x1B';
+                seq.bytes[seq.len++] = '[';
+                sgr_param(seq,"0",true);
+                if (iMode != MODE_RESET) {
+                    sgr_param(seq,s_sgrOn[iMode],false);
+                }
+                sgr_param(seq,s_sgrFg[iFg],false);
+                sgr_param(seq,s_sgrBg[iBg],false);
+                seq.bytes[seq.len++] = 'm';
+            }
+        }
+    }
+    return table;
+}();
+
+/**
+ * @brief Color key tags: the kind of color in bits 24 and up, its value below.
+ *
+ * A key is an ANSI color (0 to 7), a palette index or a 0xRRGGBB color.
+ * Keys compare equal exactly when they produce the same SGR parameter.
+ */
+static constexpr uint32_t KEY_ANSI = 0;
+static constexpr uint32_t KEY_PALETTE = 1u << 24;
+static constexpr uint32_t KEY_RGB = 2u << 24;
+
+/**
+ * @brief Channel values of the xterm 6x6x6 color cube (indices 16 to 231).
+ */
+static constexpr uint8_t s_cubeLevels[6] = {0, 95, 135, 175, 215, 255};
+
+/**
+ * @brief Returns the 0xRRGGBB value of an xterm palette entry.
+ *
+ * The 16 system colors use xterm's defaults.
+ */
+static constexpr uint32_t palette_rgb(int iIndex) {
+    constexpr uint32_t system[16] = {
+        0x000000, 0xCD0000, 0x00CD00, 0xCDCD00, 0x0000EE, 0xCD00CD, 0x00CDCD, 0xE5E5E5,
+        0x7F7F7F, 0xFF0000, 0x00FF00, 0xFFFF00, 0x5C5CFF, 0xFF00FF, 0x00FFFF, 0xFFFFFF};
+    if (iIndex < 16) {
+        return system[iIndex];
+    }
+    if (iIndex < 232) {
+        int i = iIndex - 16;
+        return crtrgb(s_cubeLevels[i / 36],s_cubeLevels[i / 6 % 6],s_cubeLevels[i % 6]);
+    }
+    uint8_t v = 8 + 10 * (iIndex - 232);
+    return crtrgb(v,v,v);
+}
+
+/**
+ * @brief Squared distance between two 0xRRGGBB colors.
+ */
+static constexpr int color_distance(uint32_t a, uint32_t b) {
+    int dr = static_cast<int>(a >> 16 & 0xFF) - static_cast<int>(b >> 16 & 0xFF);
+    int dg = static_cast<int>(a >> 8 & 0xFF) - static_cast<int>(b >> 8 & 0xFF);
+    int db = static_cast<int>(a & 0xFF) - static_cast<int>(b & 0xFF);
+    return dr * dr + dg * dg + db * db;
+}
+
+/**
+ * @brief Finds the cube or gray-ramp entry nearest to a color.
+ *
+ * The nearest cube entry is found channel by channel; the nearest gray
+ * from the mean. The closer of the two wins.
+ */
+static constexpr uint8_t nearest_palette(uint32_t rgb) {
+    auto level = [](int v) {
+        return v < 48 ? 0 : v < 115 ? 1 : (v - 35) / 40;
+    };
+    int r = rgb >> 16 & 0xFF;
+    int g = rgb >> 8 & 0xFF;
+    int b = rgb & 0xFF;
+    int iCube = 16 + 36 * level(r) + 6 * level(g) + level(b);
+    int iGray = 232 + std::clamp(((r + g + b) / 3 - 3) / 10,0,23);
+    return color_distance(rgb,palette_rgb(iCube)) <= color_distance(rgb,palette_rgb(iGray)) ? iCube : iGray;
+}
+
+/**
+ * @brief Nearest palette entry for every 15-bit (RGB555) color.
+ *
+ * Built at compile time; crtstyle_rgb() indexes it with the top five bits
+ * of each channel. Each entry is computed from the middle of its bucket.
+ */
+static constexpr auto s_rgb555 = [] {
+    std::array<uint8_t,32768> table{};
+    for (uint32_t i = 0; i < table.size(); i++) {
+        uint32_t r = i >> 10 & 31;
+        uint32_t g = i >> 5 & 31;
+        uint32_t b = i & 31;
+        table[i] = nearest_palette(crtrgb(r << 3 | r >> 2,g << 3 | g >> 2,b << 3 | b >> 2));
+    }
+    return table;
+}();
+
+/**
+ * @brief Nearest ANSI color (0 to 7) for every palette entry.
+ *
+ * A channel at half intensity or above turns on the matching ANSI bit.
+ * The bright system colors map to their normal counterparts.
+ */
+static constexpr auto s_paletteAnsi = [] {
+    std::array<uint8_t,256> table{};
+    for (int i = 0; i < 256; i++) {
+        uint32_t rgb = palette_rgb(i);
+        table[i] = i < 16 ? i & 7 : ((rgb >> 16 & 0xFF) >= 128) | ((rgb >> 8 & 0xFF) >= 128) << 1 | ((rgb & 0xFF) >= 128) << 2;
+    }
+    return table;
+}();
+
+/**
+ * @brief Writes the SGR parameter for a color key.
+ *
+ * @param p Destination.
+ * @param uKey The color key.
+ * @param chBase '3' for foreground, '4' for background.
+ * @return The end of the parameter.
+ */
+static char * sgr_color(char * p, uint32_t uKey, char chBase) {
+    *p++ = chBase;
+    switch (uKey & ~0xFFFFFFu) {
+    case KEY_ANSI:
+        *p++ = static_cast<char>('0' + uKey);
+        break;
+    case KEY_PALETTE:
+        p = std::copy_n("8;5;",4,p);
+        p = std::to_chars(p,p + 3,uKey & 0xFF).ptr;
+        break;
+    default:
+        p = std::copy_n("8;2;",4,p);
+        p = std::to_chars(p,p + 3,uKey >> 16 & 0xFF).ptr;
+        *p++ = ';';
+        p = std::to_chars(p,p + 3,uKey >> 8 & 0xFF).ptr;
+        *p++ = ';';
+        p = std::to_chars(p,p + 3,uKey & 0xFF).ptr;
+        break;
+    }
+    return p;
+}
+
+/**
+ * @brief Writes "ESC [ n <final>" with the count omitted when it is one.
+ *
+ * @param pBuf Destination buffer.
+ * @param iCount The parameter of the sequence.
+ * @param chFinal The final byte (A, B, C, D, ...).
+ * @return The number of bytes written.
+ */
+static int csi_count(char * pBuf, int iCount, char chFinal) {
+    char * p = pBuf;
+    *p++ = '\x1B';
+    *p++ = '[';
+    if (iCount != 1) {
+        p = std::to_chars(p,p + 12,iCount).ptr;
+    }
+    *p++ = chFinal;
+    return p - pBuf;
+}
+
+/**
+ * @brief Writes an absolute cursor position (CUP) sequence.
+ *
+ * Defaulted parameters are omitted: home is "ESC[H" and column one is
+ * "ESC[<line>H".
+ *
+ * @param pBuf Destination buffer.
+ * @param line 1-based line.
+ * @param col 1-based column.
+ * @return The number of bytes written.
+ */
+static int csi_cup(char * pBuf, int line, int col) {
+    char * p = pBuf;
+    *p++ = '\x1B';
+    *p++ = '[';
+    if (line != 1 || col != 1) {
+        p = std::to_chars(p,p + 12,line).ptr;
+    }
+    if (col != 1) {
+        *p++ = ';';
+        p = std::to_chars(p,p + 12,col).ptr;
+    }
+    *p++ = 'H';
+    return p - pBuf;
+}
+
+/**
+ * @brief Writes the cheapest horizontal move on the current line.
+ *
+ * Moving left by a few columns is cheaper with backspaces than with CUB.
+ *
+ * @param pBuf Destination buffer.
+ * @param iFrom Current column.
+ * @param iTo Target column.
+ * @return The number of bytes written.
+ */
+static int move_horizontal(char * pBuf, int iFrom, int iTo) {
+    if (iTo > iFrom) {
+        return csi_count(pBuf,iTo - iFrom,'C');
+    }
+    int iDist = iFrom - iTo;
+    if (iDist == 0) {
+        return 0;
+    }
+    int iLen = csi_count(pBuf,iDist,'D');
+    if (iDist <= iLen) {
+        std::memset(pBuf,'\b',iDist);
+        return iDist;
+    }
+    return iLen;
+}
 
 /**
  * @brief Default constructor for the crtbind class.
@@ -15,34 +310,266 @@
  *
  * @return A constructed crtbind object.
  */
-crtbind::crtbind() {
+crtbind::crtbind() : crtbind(crtstdout()) {
+}
 
+/**
+ * @brief Constructs a binding that delivers frames to a sink.
+ *
+ * The screen size still comes from standard output when it is a terminal,
+ * and is 24x80 otherwise; see crtsetsize().
+ *
+ * @param pSink The destination for crtflush().
+ */
+crtbind::crtbind(crtsink * pSink) {
+    m_pSink = pSink ? pSink : crtstdout();
+    m_iTextBytes = 0;
+    m_ssFrame.reserve(65536);
+    m_mode = MODE_RESET;
+    m_uFg = KEY_ANSI | (FG_WHITE - FG_BLACK);
+    m_uBg = KEY_ANSI | (BG_BLACK - BG_BLACK);
+    m_bStyleKnown = false;
+    m_iCurLine = 0;
+    m_iCurCol = 0;
+    m_iLines = 24;
+    m_iCols = 80;
+    m_bOnlcr = true;
+    m_uCaps = 0;
+    m_iFrameDepth = 0;
+    m_iFrameStart = 0;
+    m_iFrameBody = 0;
+    m_bFrameSync = false;
+    m_bFrameCursor = true;
+    m_bCursorVisible = true;
+    struct winsize ws;
+    if (::ioctl(STDOUT_FILENO,TIOCGWINSZ,&ws) == 0 && ws.ws_row > 0 && ws.ws_col > 0) {
+        m_iLines = ws.ws_row;
+        m_iCols = ws.ws_col;
+    }
 }
 
 /**
  * @brief Clears the terminal screen.
  *
  * This function uses ANSI escape codes to clear the entire
- * terminal screen. It sends the escape sequence "\x1B[2J"
+ * terminal screen. It queues the escape sequence "\x1B[2J"
  * to clear all visible content from the terminal display.
  */
 void crtbind::crtclr() {
-    std::cout << "\x1B[2J";  // ANSI escape: clear entire screen
+    m_ssFrame.append("\x1B[2J");  // ANSI escape: clear entire screen
 }
 
 /**
  * Moves the cursor to a specified position in the terminal.
  *
  * This function sets the terminal cursor to the specific `line` and `col`
- * (row and column) using ANSI escape codes. It directly interacts with
- * the terminal by outputting the escape sequence necessary to reposition
- * the cursor.
+ * (row and column) using ANSI escape codes. The escape sequence is
+ * appended to the frame buffer and reaches the terminal on the next
+ * crtflush().
+ *
+ * When the current position is known the move is planned in the spirit of
+ * curses' mvcur: nothing is emitted if the cursor is already there, and
+ * otherwise the shortest of the absolute and relative encodings is used.
  *
  * @param line The row number to which the cursor will be moved (starting from 1).
  * @param col The column number to which the cursor will be moved (starting from 1).
  */
 void crtbind::crtlc(int line, int col) {
-    std::cout << "\x1B[" << line << ";" << col << "H";
+    if (line == m_iCurLine && col == m_iCurCol) {
+        return;
+    }
+    char szSeq[64];
+    int iLen = plan_move(line,col,szSeq);
+    m_ssFrame.append(szSeq,iLen);
+    if (line >= 1 && line <= m_iLines && col >= 1 && col <= m_iCols) {
+        m_iCurLine = line;
+        m_iCurCol = col;
+    } else {
+        m_iCurLine = 0;     // the terminal clamps; do not guess where
+        m_iCurCol = 0;
+    }
+}
+
+/**
+ * Computes the size of the sequence crtlc() would emit.
+ *
+ * @param line Target 1-based line.
+ * @param col Target 1-based column.
+ * @return The number of bytes, or 0 when no move is needed.
+ */
+int crtbind::crtlc_cost(int line, int col) {
+    if (line == m_iCurLine && col == m_iCurCol) {
+        return 0;
+    }
+    char szSeq[64];
+    return plan_move(line,col,szSeq);
+}
+
+/**
+ * @brief Scrolls lines iTop to iBottom up by iCount.
+ *
+ * Emits "CSI top ; bottom r", "CSI n S" and "CSI r". Setting or resetting
+ * the region homes the cursor, which is where tracking resumes.
+ *
+ * @param iTop First line of the band (1-based).
+ * @param iBottom Last line of the band (1-based, inclusive).
+ * @param iCount Number of lines to scroll.
+ */
+void crtbind::crtscroll(int iTop, int iBottom, int iCount) {
+    if (iCount <= 0 || iTop < 1 || iBottom < iTop) {
+        return;
+    }
+    char szSeq[64];
+    char * p = szSeq;
+    *p++ = '\x1B';
+    *p++ = '[';
+    p = std::to_chars(p,p + 8,iTop).ptr;
+    *p++ = ';';
+    p = std::to_chars(p,p + 8,iBottom).ptr;
+    *p++ = 'r';
+    p += csi_count(p,iCount,'S');
+    p = std::copy_n("\x1B[r",3,p);
+    m_ssFrame.append(szSeq,p - szSeq);
+    m_iCurLine = 1;
+    m_iCurCol = 1;
+}
+
+/**
+ * @brief Chooses the cheapest encoding for a cursor move.
+ *
+ * Candidates, when the current position is known and the target is on
+ * screen:
+ * - absolute CUP, with defaulted parameters omitted;
+ * - a vertical move (CUU, CUD, or LFs when the tty leaves the column alone)
+ *   followed by a horizontal move (CUF, CUB or backspaces);
+ * - CR followed by the vertical move and CUF from column one;
+ * - LFs that also return the carriage (ONLCR) followed by CUF.
+ *
+ * @param line Target 1-based line.
+ * @param col Target 1-based column.
+ * @param pBuf Destination buffer of at least 64 bytes.
+ * @return The length of the chosen sequence.
+ */
+int crtbind::plan_move(int line, int col, char * pBuf) {
+    int iBest = csi_cup(pBuf,line,col);
+    if (m_iCurLine == 0 || line < 1 || line > m_iLines || col < 1 || col > m_iCols) {
+        return iBest;
+    }
+
+    char szVert[24];
+    int iVert = 0;
+    int iDown = line - m_iCurLine;
+    if (iDown > 0) {
+        iVert = csi_count(szVert,iDown,'B');
+        if (!m_bOnlcr && iDown < iVert) {
+            std::memset(szVert,'\n',iDown);
+            iVert = iDown;
+        }
+    } else if (iDown < 0) {
+        iVert = csi_count(szVert,-iDown,'A');
+    }
+
+    char szCand[64];
+    auto consider = [&](int iLen) {
+        if (iLen < iBest) {
+            std::memcpy(pBuf,szCand,iLen);
+            iBest = iLen;
+        }
+    };
+
+    // relative from the current position
+    std::memcpy(szCand,szVert,iVert);
+    consider(iVert + move_horizontal(szCand + iVert,m_iCurCol,col));
+
+    // carriage return, then relative from column one
+    if (col < m_iCurCol) {
+        szCand[0] = '\r';
+        std::memcpy(szCand + 1,szVert,iVert);
+        consider(1 + iVert + move_horizontal(szCand + 1 + iVert,1,col));
+    }
+
+    // line feeds that also return the carriage
+    if (m_bOnlcr && iDown > 0 && iDown < iBest) {
+        std::memset(szCand,'\n',iDown);
+        consider(iDown + move_horizontal(szCand + iDown,1,col));
+    }
+    return iBest;
+}
+
+/**
+ * @brief Records a new screen size.
+ *
+ * @param iLines Number of screen lines.
+ * @param iCols Number of screen columns.
+ */
+void crtbind::crtsetsize(int iLines, int iCols) {
+    m_iLines = iLines;
+    m_iCols = iCols;
+    m_iCurLine = 0;
+    m_iCurCol = 0;
+}
+
+/**
+ * @brief Retrieves the number of screen lines.
+ *
+ * @return The line count.
+ */
+int crtbind::crtlines() {
+    return m_iLines;
+}
+
+/**
+ * @brief Retrieves the number of screen columns.
+ *
+ * @return The column count.
+ */
+int crtbind::crtcols() {
+    return m_iCols;
+}
+
+/**
+ * @brief Set by the SIGWINCH handler, cleared by crtpoll_resize().
+ */
+static volatile std::sig_atomic_t s_bResized = 0;
+
+/**
+ * @brief SIGWINCH handler; async-signal-safe, it only records the event.
+ */
+static void on_winch(int) {
+    s_bResized = 1;
+}
+
+/**
+ * @brief Installs on_winch() for SIGWINCH.
+ *
+ * SA_RESTART is left off so that a poll(2) or read(2) waiting for input
+ * returns and the caller gets to redraw.
+ */
+void crtbind::crtwatch_resize() {
+    struct sigaction sa{};
+    sa.sa_handler = on_winch;
+    sigemptyset(&sa.sa_mask);
+    ::sigaction(SIGWINCH,&sa,nullptr);
+}
+
+/**
+ * @brief Adopts the tty size after a SIGWINCH.
+ *
+ * @return True if the size differs from the one in use.
+ */
+bool crtbind::crtpoll_resize() {
+    if (!s_bResized) {
+        return false;
+    }
+    s_bResized = 0;
+    struct winsize ws;
+    if (::ioctl(STDOUT_FILENO,TIOCGWINSZ,&ws) != 0 || ws.ws_row == 0 || ws.ws_col == 0 ||
+        (ws.ws_row == m_iLines && ws.ws_col == m_iCols)) {
+        return false;
+    }
+    crtsetsize(ws.ws_row,ws.ws_col);
+    crtinvalidate();
+    return true;
 }
 
 /**
@@ -52,10 +579,722 @@ void crtbind::crtlc(int line, int col) {
  * foreground color, and background color. It uses ANSI escape codes to set
  * the desired text attributes.
  *
+ * The attributes last sent are remembered. A call that changes nothing emits
+ * nothing; otherwise only the differing parameters are sent, using the
+ * mode's cancel code when one mode replaces another. When the terminal
+ * state is unknown the complete sequence comes from s_sgrFull.
+ *
  * @param mode Specifies the text mode (e.g., bold, underline, reset).
  * @param fg Specifies the foreground color for the text.
  * @param bg Specifies the background color for the text.
  */
 void crtbind::crtstyle(MODE_T mode, FG_COLORS_T fg, BG_COLORS_T bg) {
-    std::cout << "\x1B[" << mode << ";" << fg << ";" << bg << "m";
+    if (mode < 0 || mode >= SGR_MODES ||
+        fg < FG_BLACK || fg > FG_WHITE || bg < BG_BLACK || bg > BG_WHITE) {
+        char szSeq[32];
+        int iLen = std::snprintf(szSeq,sizeof(szSeq),"\x1B[%d;%d;%dm",mode,fg,bg);
+        m_ssFrame.append(szSeq,iLen);
+        m_bStyleKnown = false;
+        return;
+    }
+    uint32_t uFg = KEY_ANSI | (fg - FG_BLACK);
+    uint32_t uBg = KEY_ANSI | (bg - BG_BLACK);
+    if (!m_bStyleKnown) {
+        const sgrseq & seq = s_sgrFull[(mode * 8 + fg - FG_BLACK) * 8 + bg - BG_BLACK];
+        m_ssFrame.append(seq.bytes,seq.len);
+    } else {
+        if (mode == m_mode && uFg == m_uFg && uBg == m_uBg) {
+            return;
+        }
+        sgrseq seq{};
+        seq.bytes[seq.len++] = '\x1B';
+        seq.bytes[seq.len++] = '[';
+        bool bFirst = true;
+        bool bColorsReset = false;
+        if (mode != m_mode) {
+            if (mode == MODE_RESET) {
+                sgr_param(seq,s_sgrOn[MODE_RESET],bFirst);
+                bColorsReset = true;
+            } else {
+                if (m_mode != MODE_RESET) {
+                    sgr_param(seq,s_sgrOff[m_mode],bFirst);
+                    bFirst = false;
+                }
+                sgr_param(seq,s_sgrOn[mode],bFirst);
+            }
+            bFirst = false;
+        }
+        if (bColorsReset || uFg != m_uFg) {
+            sgr_param(seq,s_sgrFg[fg - FG_BLACK],bFirst);
+            bFirst = false;
+        }
+        if (bColorsReset || uBg != m_uBg) {
+            sgr_param(seq,s_sgrBg[bg - BG_BLACK],bFirst);
+        }
+        seq.bytes[seq.len++] = 'm';
+        m_ssFrame.append(seq.bytes,seq.len);
+    }
+    m_mode = mode;
+    m_uFg = uFg;
+    m_uBg = uBg;
+    m_bStyleKnown = true;
+}
+
+/**
+ * @brief Sets mode and colors given as color keys.
+ *
+ * Follows the same rules as crtstyle(): a complete reset-and-set sequence
+ * when the state is unknown, otherwise only what changed.
+ *
+ * @param mode The text mode; values outside MODE_T select MODE_RESET.
+ * @param uFg Foreground color key.
+ * @param uBg Background color key.
+ */
+void crtbind::style_keys(MODE_T mode, uint32_t uFg, uint32_t uBg) {
+    if (mode < 0 || mode >= SGR_MODES) {
+        mode = MODE_RESET;
+    }
+    if (m_bStyleKnown && mode == m_mode && uFg == m_uFg && uBg == m_uBg) {
+        return;
+    }
+    char szSeq[64];
+    char * p = szSeq;
+    *p++ = '\x1B';
+    *p++ = '[';
+    bool bFirst = true;
+    auto param = [&](std::string_view ssParam) {
+        if (!bFirst) {
+            *p++ = ';';
+        }
+        bFirst = false;
+        p = std::copy(ssParam.begin(),ssParam.end(),p);
+    };
+    bool bColorsReset = false;
+    if (!m_bStyleKnown || (mode != m_mode && mode == MODE_RESET)) {
+        param(s_sgrOn[MODE_RESET]);
+        if (mode != MODE_RESET) {
+            param(s_sgrOn[mode]);
+        }
+        bColorsReset = true;
+    } else if (mode != m_mode) {
+        if (m_mode != MODE_RESET) {
+            param(s_sgrOff[m_mode]);
+        }
+        param(s_sgrOn[mode]);
+    }
+    if (bColorsReset || uFg != m_uFg) {
+        param("");
+        p = sgr_color(p,uFg,'3');
+    }
+    if (bColorsReset || uBg != m_uBg) {
+        param("");
+        p = sgr_color(p,uBg,'4');
+    }
+    *p++ = 'm';
+    m_ssFrame.append(szSeq,p - szSeq);
+    m_mode = mode;
+    m_uFg = uFg;
+    m_uBg = uBg;
+    m_bStyleKnown = true;
+}
+
+/**
+ * @brief Sets the style with xterm palette colors.
+ *
+ * Without CAP_256 each index is replaced by its nearest ANSI color.
+ *
+ * @param mode The text mode.
+ * @param fg Foreground palette index.
+ * @param bg Background palette index.
+ */
+void crtbind::crtstyle_256(MODE_T mode, uint8_t fg, uint8_t bg) {
+    if (m_uCaps & CAP_256) {
+        style_keys(mode,KEY_PALETTE | fg,KEY_PALETTE | bg);
+    } else {
+        style_keys(mode,KEY_ANSI | s_paletteAnsi[fg],KEY_ANSI | s_paletteAnsi[bg]);
+    }
+}
+
+/**
+ * @brief Sets the style with 24-bit colors.
+ *
+ * With CAP_RGB the colors go out as they are. Otherwise each is cut to
+ * RGB555 and looked up in s_rgb555, then handled as by crtstyle_256().
+ *
+ * @param mode The text mode.
+ * @param fg Foreground color, 0xRRGGBB.
+ * @param bg Background color, 0xRRGGBB.
+ */
+void crtbind::crtstyle_rgb(MODE_T mode, uint32_t fg, uint32_t bg) {
+    if (m_uCaps & CAP_RGB) {
+        style_keys(mode,KEY_RGB | (fg & 0xFFFFFF),KEY_RGB | (bg & 0xFFFFFF));
+        return;
+    }
+    auto rgb555 = [](uint32_t rgb) {
+        return (rgb >> 9 & 0x7C00) | (rgb >> 6 & 0x03E0) | (rgb >> 3 & 0x001F);
+    };
+    crtstyle_256(mode,s_rgb555[rgb555(fg)],s_rgb555[rgb555(bg)]);
+}
+
+/**
+ * @brief Finds the palette entry nearest to a 24-bit color.
+ *
+ * Exact, unlike the table crtstyle_rgb() uses, which first cuts each
+ * channel to five bits.
+ *
+ * @param rgb The color, 0xRRGGBB.
+ * @return A palette index from 16 to 255.
+ */
+uint8_t crtbind::crtpalette_index(uint32_t rgb) {
+    return nearest_palette(rgb & 0xFFFFFF);
+}
+
+/**
+ * @brief Forgets the remembered terminal attributes and cursor position.
+ *
+ * The next crtstyle() call emits a complete reset-and-set sequence and the
+ * next crtlc() an absolute position.
+ */
+void crtbind::crtinvalidate() {
+    m_bStyleKnown = false;
+    m_iCurLine = 0;
+    m_iCurCol = 0;
+}
+
+/**
+ * @brief Copies capabilities, screen size and newline mode from another
+ * instance and forgets style and cursor.
+ *
+ * @param other The instance to copy the settings from.
+ */
+void crtbind::crtmatch(const crtbind & other) {
+    m_uCaps = other.m_uCaps;
+    m_iLines = other.m_iLines;
+    m_iCols = other.m_iCols;
+    m_bOnlcr = other.m_bOnlcr;
+    crtinvalidate();
+}
+
+/**
+ * @brief Splices another instance's pending bytes onto this frame.
+ *
+ * The bytes were encoded against the other instance's state, so that
+ * state (style and cursor) is what the terminal will be in afterwards.
+ *
+ * @param other The instance whose frame is taken; left empty.
+ */
+void crtbind::crtappend(crtbind & other) {
+    crtreplay(other);
+    other.crtdiscard();
+}
+
+/**
+ * @brief Copies another instance's pending bytes onto this frame.
+ *
+ * As with crtappend(), the other instance's style and cursor state become
+ * this one's when it had any bytes.
+ *
+ * @param other The instance whose frame is copied; left unchanged.
+ */
+void crtbind::crtreplay(const crtbind & other) {
+    if (other.m_ssFrame.empty()) {
+        return;
+    }
+    m_ssFrame.append(other.m_ssFrame);
+    m_iTextBytes += other.m_iTextBytes;
+    m_mode = other.m_mode;
+    m_uFg = other.m_uFg;
+    m_uBg = other.m_uBg;
+    m_bStyleKnown = other.m_bStyleKnown;
+    m_iCurLine = other.m_iCurLine;
+    m_iCurCol = other.m_iCurCol;
+}
+
+/**
+ * @brief Empties the frame buffer without writing it anywhere.
+ *
+ * The tracked style and cursor are kept; they describe the bytes that were
+ * encoded, which is what crtreplay() passes on.
+ */
+void crtbind::crtdiscard() {
+    m_ssFrame.clear();
+    m_iTextBytes = 0;
+}
+
+/**
+ * @brief Advances the tracked cursor over emitted bytes.
+ *
+ * Printable text moves right by its display width (see utf8_width()), CR
+ * returns to column one, LF moves down (and returns the carriage when ONLCR
+ * is in effect) and backspace moves left. Escape sequences and other
+ * controls, or running past the right margin, leave the position unknown.
+ *
+ * @param ssBytes The emitted bytes.
+ * @param iTimes The number of consecutive copies of ssBytes.
+ */
+void crtbind::track(std::string_view ssBytes, int iTimes) {
+    if (m_iCurCol == 0) {
+        return;
+    }
+    size_t iStart = 0;
+    for (size_t i = 0; i < ssBytes.size(); i++) {
+        unsigned char ch = ssBytes[i];
+        if (ch >= 0x20 && ch != 0x7F) {
+            continue;
+        }
+        if (iTimes != 1) {
+            m_iCurLine = m_iCurCol = 0;
+            return;
+        }
+        m_iCurCol += utf8_width(ssBytes.substr(iStart,i - iStart));
+        iStart = i + 1;
+        if (m_iCurCol > m_iCols) {
+            m_iCurLine = m_iCurCol = 0;
+            return;
+        }
+        switch (ch) {
+            case '\r':
+                m_iCurCol = 1;
+                break;
+            case '\n':
+                m_iCurLine = std::min(m_iCurLine + 1,m_iLines);
+                if (m_bOnlcr) {
+                    m_iCurCol = 1;
+                }
+                break;
+            case '\b':
+                m_iCurCol = std::max(m_iCurCol - 1,1);
+                break;
+            default:
+                m_iCurLine = m_iCurCol = 0;
+                return;
+        }
+    }
+    m_iCurCol += utf8_width(ssBytes.substr(iStart)) * iTimes;
+    if (m_iCurCol > m_iCols) {
+        m_iCurLine = m_iCurCol = 0;
+    }
+}
+
+/**
+ * Appends raw bytes to the frame buffer.
+ *
+ * @param ssBytes The bytes to append.
+ */
+void crtbind::crtputs(std::string_view ssBytes) {
+    m_ssFrame.append(ssBytes);
+    m_iTextBytes += ssBytes.size();
+    track(ssBytes,1);
+}
+
+/**
+ * Appends printable bytes of known display width.
+ *
+ * @param ssBytes The bytes to append.
+ * @param iCells The number of columns they occupy.
+ */
+void crtbind::crtputcells(std::string_view ssBytes, int iCells) {
+    m_ssFrame.append(ssBytes);
+    m_iTextBytes += ssBytes.size();
+    if (m_iCurCol != 0) {
+        m_iCurCol += iCells;
+        if (m_iCurCol > m_iCols) {
+            m_iCurLine = m_iCurCol = 0;
+        }
+    }
+}
+
+/**
+ * Appends a byte sequence to the frame buffer iCount times.
+ *
+ * With CAP_REP, a single printable glyph is sent once and the remaining
+ * repetitions are requested with CSI n b when that is shorter.
+ *
+ * @param ssBytes The bytes to repeat.
+ * @param iCount The number of repetitions.
+ */
+void crtbind::crtrepeat(std::string_view ssBytes, int iCount) {
+    if (iCount <= 0) {
+        return;
+    }
+    track(ssBytes,iCount);
+    if ((m_uCaps & CAP_REP) && iCount > 1 && !ssBytes.empty() &&
+        static_cast<unsigned char>(ssBytes[0]) >= 0x20 && ssBytes[0] != 0x7F &&
+        static_cast<size_t>(utf8_seqlen(ssBytes[0])) == ssBytes.size()) {
+        char szSeq[16];
+        int iLen = csi_count(szSeq,iCount - 1,'b');
+        if (ssBytes.size() + iLen < ssBytes.size() * iCount) {
+            m_ssFrame.append(ssBytes);
+            m_ssFrame.append(szSeq,iLen);
+            m_iTextBytes += ssBytes.size();
+            return;
+        }
+    }
+    m_iTextBytes += ssBytes.size() * iCount;
+    if (ssBytes.size() == 1) {
+        m_ssFrame.append(iCount,ssBytes[0]);
+        return;
+    }
+    m_ssFrame.reserve(m_ssFrame.size() + ssBytes.size() * iCount);
+    for (int i = 0; i < iCount; i++) {
+        m_ssFrame.append(ssBytes);
+    }
+}
+
+/**
+ * Writes blank columns using the cheapest available encoding.
+ *
+ * ECH erases in place, so it is followed by a forward move to leave the
+ * cursor where the spaces would have.
+ *
+ * @param iCount The number of blank columns.
+ */
+void crtbind::crtpad(int iCount) {
+    if (iCount <= 0) {
+        return;
+    }
+    if (m_uCaps & CAP_ECH) {
+        char szSeq[48];
+        int iLen = csi_count(szSeq,iCount,'X');
+        iLen += csi_count(szSeq + iLen,iCount,'C');
+        int iRepLen = (m_uCaps & CAP_REP) ? 1 + csi_count(szSeq + iLen,iCount - 1,'b') : iCount;
+        if (iLen < iCount && iLen <= iRepLen && m_iCurCol != 0 && m_iCurCol + iCount <= m_iCols) {
+            m_ssFrame.append(szSeq,iLen);
+            m_iCurCol += iCount;
+            return;
+        }
+    }
+    crtrepeat(" ",iCount);
+}
+
+/**
+ * @brief Enables optional terminal capabilities.
+ *
+ * @param uCaps CAPS_T flags.
+ */
+void crtbind::crtsetcaps(unsigned uCaps) {
+    m_uCaps = uCaps;
+}
+
+/**
+ * @brief Retrieves the enabled terminal capabilities.
+ *
+ * @return CAPS_T flags.
+ */
+unsigned crtbind::crtcaps() {
+    return m_uCaps;
+}
+
+/**
+ * @brief Guesses terminal capabilities from $TERM and $COLORTERM.
+ *
+ * Only families known to implement the sequences are listed; anything else
+ * gets the portable fallbacks. The first matching prefix wins, so specific
+ * families (kitty's "xterm-kitty") come before generic ones ("xterm"). A "256color" $TERM adds CAP_256, and
+ * $COLORTERM set to "truecolor" or "24bit" adds CAP_RGB.
+ *
+ * @return CAPS_T flags.
+ */
+unsigned crtbind::crtcaps_from_env() {
+    static const struct {
+        std::string_view ssPrefix;
+        unsigned uCaps;
+    } termcaps[] = {
+        // specific families before the generic prefixes they share
+        {"xterm-kitty", CAP_REP | CAP_ECH | CAP_SYNC | CAP_256},
+        {"kitty",       CAP_REP | CAP_ECH | CAP_SYNC | CAP_256},
+        {"foot",        CAP_REP | CAP_ECH | CAP_SYNC | CAP_256},
+        {"contour",     CAP_REP | CAP_ECH | CAP_SYNC},
+        {"alacritty",   CAP_ECH | CAP_SYNC | CAP_256},
+        {"tmux",        CAP_REP | CAP_ECH | CAP_SYNC},
+        {"xterm",       CAP_REP | CAP_ECH},
+        {"screen",      CAP_ECH},
+        {"rxvt",        CAP_ECH},
+        {"linux",       CAP_ECH},
+        {"vt220",       CAP_ECH},
+    };
+    unsigned uCaps = 0;
+    const char * pszTerm = std::getenv("TERM");
+    if (pszTerm != nullptr) {
+        std::string_view ssTerm(pszTerm);
+        for (const auto & entry : termcaps) {
+            if (ssTerm.starts_with(entry.ssPrefix)) {
+                uCaps = entry.uCaps;
+                break;
+            }
+        }
+        if (ssTerm.find("256color") != std::string_view::npos) {
+            uCaps |= CAP_256;
+        }
+    }
+    const char * pszColor = std::getenv("COLORTERM");
+    if (pszColor != nullptr) {
+        std::string_view ssColor(pszColor);
+        if (ssColor == "truecolor" || ssColor == "24bit") {
+            uCaps |= CAP_256 | CAP_RGB;
+        }
+    }
+    return uCaps;
+}
+
+/**
+ * @brief Delivers the pending frame to the sink as one block.
+ *
+ * An empty frame is not delivered, so idle flushes cost nothing. A
+ * delivered frame is closed in renderstats with its byte split and write
+ * count. Inside a frame transaction nothing happens; end_frame() flushes.
+ */
+void crtbind::crtflush() {
+    if (m_iFrameDepth > 0 || m_ssFrame.empty()) {
+        return;
+    }
+    {
+        renderspan span("crtbind::crtflush",PHASE_FLUSH);
+        uint64_t iWrites = m_pSink->get_writes();
+        if (m_pInput && m_pInput->get_fd() >= 0 && m_ssFrame.size() > FLUSH_CHUNK) {
+            flush_pumped();
+        } else {
+            m_pSink->write(m_ssFrame.data(),m_ssFrame.size());
+        }
+        if (renderstats::enabled()) {
+            framestats & stats = renderstats::current();
+            stats.iGlyphBytes += m_iTextBytes;
+            stats.iEscapeBytes += m_ssFrame.size() - m_iTextBytes;
+            stats.iWrites += m_pSink->get_writes() - iWrites;
+        }
+    }
+    m_ssFrame.clear();
+    m_iTextBytes = 0;
+    renderstats::end_frame();
+}
+
+/**
+ * @brief Writes the frame in FLUSH_CHUNK pieces, decoding input between them.
+ *
+ * A terminal that is slow to drain a large frame would otherwise hold the
+ * program in write(2) with keys piling up unread. When the sink has a
+ * descriptor, poll(2) waits for room on it and for input at once, so a key
+ * reaches the decoder (and its hook) as soon as it arrives rather than
+ * when the next piece has gone out.
+ */
+void crtbind::flush_pumped() {
+    const char * pData = m_ssFrame.data();
+    size_t iLeft = m_ssFrame.size();
+    int fdOut = m_pSink->get_fd();
+    while (iLeft > 0) {
+        if (fdOut >= 0) {
+            struct pollfd pfd[2] = {{fdOut,POLLOUT,0},{m_pInput->get_fd(),POLLIN,0}};
+            if (::poll(pfd,2,-1) < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                fdOut = -1;     // write blind, pumping between pieces
+            }
+            if (pfd[1].revents) {
+                m_pInput->pump();
+            }
+            if (fdOut >= 0 && !pfd[0].revents) {
+                continue;
+            }
+        }
+        size_t iPiece = std::min(iLeft,FLUSH_CHUNK);
+        if (!m_pSink->write(pData,iPiece)) {
+            return;
+        }
+        pData += iPiece;
+        iLeft -= iPiece;
+        if (fdOut < 0) {
+            m_pInput->pump();
+        }
+    }
+}
+
+/**
+ * @brief Makes a terminal raw and attaches it to the input decoder.
+ *
+ * @param uModes INPUT_T reporting modes.
+ * @param fd The descriptor to read.
+ * @return True if the descriptor is attached.
+ */
+bool crtbind::crtraw(unsigned uModes,int fd) {
+    crtflush();
+    return crtgetinput()->attach(fd,uModes);
+}
+
+/**
+ * @brief Detaches the input decoder, restoring the terminal.
+ */
+void crtbind::crtcooked() {
+    if (m_pInput) {
+        m_pInput->detach();
+    }
+}
+
+/**
+ * @brief Reads what input is available and takes the next key.
+ *
+ * @param key Receives the key.
+ * @return False if none is waiting.
+ */
+bool crtbind::crtgetkey(crtkey & key) {
+    if (!m_pInput) {
+        return false;
+    }
+    m_pInput->pump();
+    return m_pInput->pop(key);
+}
+
+/**
+ * @brief Waits for a key; see crtinput::wait().
+ *
+ * @param iTimeoutMs Longest wait in milliseconds; negative waits forever.
+ * @return True if a key is waiting.
+ */
+bool crtbind::crtwaitkey(int iTimeoutMs) {
+    return crtgetinput()->wait(iTimeoutMs);
+}
+
+/**
+ * @brief Retrieves the input decoder, creating it on first use.
+ *
+ * @return The decoder, owned by the binding.
+ */
+crtinput * crtbind::crtgetinput() {
+    if (!m_pInput) {
+        m_pInput = std::make_unique<crtinput>();
+    }
+    return m_pInput.get();
+}
+
+/**
+ * @brief Redirects subsequent frames to another sink.
+ *
+ * @param pSink The destination, or nullptr for standard output.
+ */
+void crtbind::crtsetsink(crtsink * pSink) {
+    m_pSink = pSink ? pSink : crtstdout();
+}
+
+/**
+ * @brief Retrieves the sink frames are delivered to.
+ *
+ * @return The current sink.
+ */
+crtsink * crtbind::crtgetsink() {
+    return m_pSink;
+}
+
+/**
+ * @brief Retrieves the shared standard output sink.
+ *
+ * @return An fdsink for STDOUT_FILENO.
+ */
+crtsink * crtbind::crtstdout() {
+    static fdsink s_stdout(STDOUT_FILENO);
+    return &s_stdout;
+}
+
+/**
+ * @brief Shows or hides the cursor.
+ *
+ * Inside a frame transaction the change is only recorded; end_frame()
+ * leaves the cursor in the recorded state.
+ *
+ * @param bVisible True to show the cursor.
+ */
+void crtbind::crtsetcursor(bool bVisible) {
+    m_bCursorVisible = bVisible;
+    if (m_iFrameDepth == 0) {
+        m_ssFrame.append(bVisible ? "\x1B[?25h" : "\x1B[?25l");
+    }
+}
+
+/**
+ * @brief Tells whether the cursor is shown.
+ *
+ * @return The state last set with crtsetcursor(); true initially.
+ */
+bool crtbind::crtcursor() {
+    return m_bCursorVisible;
+}
+
+/**
+ * @brief Opens a frame transaction.
+ *
+ * Only the outermost call marks where the staged output begins; bytes
+ * already pending stay in front of it and go out in the same write. The
+ * prefix that end_frame() needs is appended here, so committing never
+ * moves the staged bytes: "CSI ? 2026 h" with CAP_SYNC, and "CSI ? 25 l"
+ * unless the cursor is already hidden.
+ */
+void crtbind::begin_frame() {
+    if (m_iFrameDepth++ == 0) {
+        m_iFrameStart = m_ssFrame.size();
+        m_bFrameSync = m_uCaps & CAP_SYNC;
+        m_bFrameCursor = m_bCursorVisible;
+        if (m_bFrameSync) {
+            m_ssFrame.append("\x1B[?2026h");
+        }
+        if (m_bCursorVisible) {
+            m_ssFrame.append("\x1B[?25l");
+        }
+        m_iFrameBody = m_ssFrame.size();
+    }
+}
+
+/**
+ * @brief Commits the outermost frame transaction.
+ *
+ * The cursor is hidden while the frame is drawn so it is not seen jumping
+ * around, and afterwards put back the way crtsetcursor() last left it.
+ * With CAP_SYNC the frame is also bracketed by "CSI ? 2026 h" and
+ * "CSI ? 2026 l"; terminals that support mode 2026 keep showing the
+ * previous frame until the reset arrives and then repaint once. The
+ * prefix was appended by begin_frame(); a transaction that staged nothing
+ * drops it and emits only a cursor change made inside it, unbracketed.
+ * Unbalanced calls are ignored.
+ */
+void crtbind::end_frame() {
+    if (m_iFrameDepth == 0 || --m_iFrameDepth > 0) {
+        return;
+    }
+    if (m_ssFrame.size() > m_iFrameBody) {
+        if (m_bCursorVisible) {
+            m_ssFrame.append("\x1B[?25h");
+        }
+        if (m_bFrameSync) {
+            m_ssFrame.append("\x1B[?2026l");
+        }
+    } else if (m_ssFrame.size() == m_iFrameBody) {
+        m_ssFrame.resize(m_iFrameStart);
+        if (m_bCursorVisible != m_bFrameCursor) {
+            m_ssFrame.append(m_bCursorVisible ? "\x1B[?25h" : "\x1B[?25l");
+        }
+    }
+    crtflush();
+}
+
+/**
+ * @brief Tells whether a frame transaction is open.
+ *
+ * @return True between begin_frame() and the matching end_frame().
+ */
+bool crtbind::in_frame() {
+    return m_iFrameDepth > 0;
+}
+
+/**
+ * @brief Destructor for the crtbind class.
+ *
+ * Commits a transaction left open and flushes whatever is left in the
+ * frame buffer so that no output is lost when the binding goes out of
+ * scope, then restores a terminal left in raw mode.
+ */
+crtbind::~crtbind() {
+    if (m_iFrameDepth > 0) {
+        m_iFrameDepth = 1;
+        end_frame();
+    }
+    crtflush();
+    m_pInput.reset();
 }
\ No newline at end of file
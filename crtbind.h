@@ -6,6 +6,15 @@
 #ifndef CRTBIND_H
 #define CRTBIND_H
 
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include "crtinput.h"
+#include "crtsink.h"
+
 /**
  * @enum MODE_T
  * @brief Represents text style modes for terminal formatting.
@@ -25,13 +34,13 @@
  * - MODE_STRIKE: Strikethrough text.
  */
 enum MODE_T {
-    MODE_RESET = 30,    // Reset all attributes
+    MODE_RESET = 0,     // Reset all attributes
     MODE_BOLD,          // Bold text
     MODE_DIM,           // Dim text
     MODE_ITALIC,        // Italic text
     MODE_UNDERLINE,     // Underlined text
     MODE_BLINK,         // Blinking text
-    MODE_REVERSE = 37,  // Reverse video
+    MODE_REVERSE = 7,   // Reverse video
     MODE_HIDDEN,        // Hidden text
     MODE_STRIKE         // Strikethrough text
 };
@@ -76,6 +85,36 @@ enum BG_COLORS_T {
     BG_BLUE, BG_MAGENTA, BG_CYAN, BG_WHITE
 };
 
+/**
+ * @enum CAPS_T
+ * @brief Optional terminal capabilities that crtbind may take advantage of.
+ *
+ * Capabilities are off unless enabled with crtbind::crtsetcaps(); without
+ * them crtbind falls back to sequences every ANSI terminal understands.
+ *
+ * - CAP_REP: CSI n b repeats the preceding graphic character n times.
+ * - CAP_ECH: CSI n X erases n characters from the cursor without moving it.
+ * - CAP_256: SGR 38;5;n and 48;5;n select from the xterm 256-color palette.
+ * - CAP_RGB: SGR 38;2;r;g;b and 48;2;r;g;b select 24-bit colors (truecolor).
+ * - CAP_SYNC: DEC private mode 2026 (synchronized output) holds the display
+ *   until the whole frame has been parsed.
+ */
+enum CAPS_T {
+    CAP_REP = 0x0001,   // repeat preceding character (REP)
+    CAP_ECH = 0x0002,   // erase characters (ECH)
+    CAP_256 = 0x0004,   // xterm 256-color palette
+    CAP_RGB = 0x0008,   // 24-bit truecolor
+    CAP_SYNC = 0x0010   // synchronized output (DEC mode 2026)
+};
+
+/**
+ * @brief Packs 8-bit red, green and blue into a 0xRRGGBB color for
+ * crtbind::crtstyle_rgb().
+ */
+constexpr uint32_t crtrgb(uint8_t r,uint8_t g,uint8_t b) {
+    return static_cast<uint32_t>(r) << 16 | static_cast<uint32_t>(g) << 8 | b;
+}
+
 /**
  * @class crtbind
  * @brief A class for terminal screen manipulation and styling.
@@ -86,6 +125,136 @@ enum BG_COLORS_T {
  * and background colors, as well as text modes like bold, underline, and more.
  */
 class crtbind {
+public:
+    /**
+     * @brief Largest piece of a frame written at once while input is
+     * attached; PIPE_BUF, so a piece fits whenever poll(2) reports room.
+     */
+    static constexpr size_t FLUSH_CHUNK = 4096;
+
+private:
+    /**
+     * @brief Pending output for the current frame.
+     *
+     * Every escape sequence and glyph produced by crtbind, semigraphics and
+     * window is appended here rather than streamed to std::cout, so that a
+     * complete frame reaches the kernel in a single write(2) from crtflush().
+     */
+    std::string m_ssFrame;
+    /**
+     * @brief Where crtflush() delivers the frame; not owned.
+     */
+    crtsink * m_pSink;
+    /**
+     * @brief Bytes of m_ssFrame that are glyphs or caller text rather than
+     * sequences generated here; reported through renderstats.
+     */
+    size_t m_iTextBytes;
+    /**
+     * @brief Text mode currently in effect on the terminal.
+     */
+    MODE_T m_mode;
+    /**
+     * @brief Foreground color currently in effect on the terminal, as a
+     * color key (see KEY_ANSI in crtbind.cpp).
+     */
+    uint32_t m_uFg;
+    /**
+     * @brief Background color currently in effect on the terminal, as a
+     * color key.
+     */
+    uint32_t m_uBg;
+    /**
+     * @brief True once m_mode, m_uFg and m_uBg reflect the terminal state.
+     *
+     * While false, the next crtstyle() emits a complete sequence that
+     * starts with a reset so the terminal ends up in a known state.
+     */
+    bool m_bStyleKnown;
+    /**
+     * @brief 1-based line the terminal cursor is on, or 0 when unknown.
+     */
+    int m_iCurLine;
+    /**
+     * @brief 1-based column the terminal cursor is on, or 0 when unknown.
+     */
+    int m_iCurCol;
+    /**
+     * @brief Number of lines on the terminal screen.
+     */
+    int m_iLines;
+    /**
+     * @brief Number of columns on the terminal screen.
+     */
+    int m_iCols;
+    /**
+     * @brief True when the tty translates '\n' into CR-LF on output (ONLCR).
+     */
+    bool m_bOnlcr;
+    /**
+     * @brief CAPS_T flags enabled for this terminal.
+     */
+    unsigned m_uCaps;
+    /**
+     * @brief Nesting depth of begin_frame() calls; 0 outside a transaction.
+     */
+    int m_iFrameDepth;
+    /**
+     * @brief Offset in m_ssFrame where the open transaction's output starts.
+     */
+    size_t m_iFrameStart;
+    /**
+     * @brief Offset in m_ssFrame just past the prefix begin_frame() wrote;
+     * nothing was staged while the frame ends here.
+     */
+    size_t m_iFrameBody;
+    /**
+     * @brief True when the open transaction began synchronized output.
+     */
+    bool m_bFrameSync;
+    /**
+     * @brief Cursor visibility when the open transaction began.
+     */
+    bool m_bFrameCursor;
+    /**
+     * @brief Cursor visibility as set with crtsetcursor(); end_frame()
+     * restores it.
+     */
+    bool m_bCursorVisible;
+    /**
+     * @brief Keyboard and mouse input, created by crtraw() or crtgetinput().
+     */
+    std::unique_ptr<crtinput> m_pInput;
+    /**
+     * @brief Hands the frame to the sink in pieces, decoding input between
+     * them.
+     */
+    void flush_pumped();
+    /**
+     * @brief Builds the cheapest byte sequence that moves the cursor.
+     *
+     * @param line Target 1-based line.
+     * @param col Target 1-based column.
+     * @param pBuf Receives the sequence; must hold at least 64 bytes.
+     * @return The length of the sequence written to pBuf.
+     */
+    int plan_move(int line,int col,char * pBuf);
+    /**
+     * @brief Advances the tracked cursor over bytes about to be emitted.
+     *
+     * @param ssBytes The bytes appended to the frame.
+     * @param iTimes How many consecutive copies of ssBytes were appended.
+     */
+    void track(std::string_view ssBytes,int iTimes);
+    /**
+     * @brief Sets mode and colors given as color keys, emitting only the
+     * SGR parameters that differ.
+     *
+     * @param mode The text mode.
+     * @param uFg Foreground color key.
+     * @param uBg Background color key.
+     */
+    void style_keys(MODE_T mode,uint32_t uFg,uint32_t uBg);
     /**
      * @brief Constructor for the crtbind class.
      *
@@ -96,23 +265,152 @@ class crtbind {
      */
 public:
     crtbind();
+    /**
+     * @brief Constructs a binding whose frames go to the given sink.
+     *
+     * @param pSink The destination; it must outlive the binding.
+     */
+    explicit crtbind(crtsink * pSink);
+    /**
+     * @brief Redirects subsequent frames to another sink.
+     *
+     * Pending bytes are not flushed; they go to the new sink.
+     *
+     * @param pSink The destination; nullptr selects standard output.
+     */
+    void crtsetsink(crtsink * pSink);
+    /**
+     * @brief Retrieves the sink frames are delivered to.
+     */
+    crtsink * crtgetsink();
+    /**
+     * @brief Retrieves the shared sink for standard output, the default.
+     */
+    static crtsink * crtstdout();
     /**
      * @brief Clears the terminal screen using ANSI escape codes.
      *
-     * This method sends an ANSI escape code to the terminal to clear the entire screen.
+     * This method queues an ANSI escape code that clears the entire screen.
      * It is typically used to reset the terminal display for subsequent updates.
      */
     void crtclr();
     /**
      * Moves the cursor to the specified position in the terminal.
      *
+     * The binding tracks where the cursor is and picks the shortest of an
+     * absolute CUP, relative CUU/CUD/CUF/CUB moves, CR, LF and backspaces.
+     *
      * @param line The line number to move the cursor to (1-based index).
      * @param col The column number to move the cursor to (1-based index).
      */
     void crtlc(int line,int col);
+    /**
+     * Computes how many bytes crtlc() would emit for a move, without moving.
+     *
+     * Renderers compare this against the cost of reprinting the cells in
+     * between, which is sometimes cheaper still.
+     *
+     * @param line Target 1-based line.
+     * @param col Target 1-based column.
+     * @return The number of bytes, 0 when the cursor is already there.
+     */
+    int crtlc_cost(int line,int col);
+    /**
+     * Scrolls a band of whole screen lines up, leaving blank lines below.
+     *
+     * Sets the scroll region (DECSTBM), scrolls it with SU and resets the
+     * region again, so later output is not confined. Lines outside the
+     * band stay put. The cursor ends up at the home position.
+     *
+     * @param iTop First line of the band (1-based).
+     * @param iBottom Last line of the band (1-based, inclusive).
+     * @param iCount Number of lines to scroll; values below one do nothing.
+     */
+    void crtscroll(int iTop,int iBottom,int iCount);
+    /**
+     * @brief Tells the binding how large the terminal screen is.
+     *
+     * The size is queried from the tty at construction; call this when it
+     * changes. Cursor tracking stops at the right margin, where the
+     * terminal's wrap behaviour makes the position ambiguous.
+     *
+     * @param iLines Number of screen lines.
+     * @param iCols Number of screen columns.
+     */
+    void crtsetsize(int iLines,int iCols);
+    /**
+     * @brief Retrieves the number of screen lines.
+     */
+    int crtlines();
+    /**
+     * @brief Retrieves the number of screen columns.
+     */
+    int crtcols();
+    /**
+     * @brief Installs a SIGWINCH handler that records terminal resizes.
+     *
+     * The handler only sets a flag; crtpoll_resize() acts on it. Blocking
+     * calls such as poll(2) return with EINTR when the signal arrives, so
+     * a wait loop wakes up for the resize.
+     */
+    static void crtwatch_resize();
+    /**
+     * @brief Picks up a resize recorded since the last call.
+     *
+     * Queries the tty size, adopts it with crtsetsize() and forgets the
+     * remembered state, since the terminal may have reflowed the screen.
+     *
+     * @return True if the size changed; the caller should redraw.
+     */
+    bool crtpoll_resize();
+    /**
+     * @brief Puts a terminal in raw mode and starts decoding its input.
+     *
+     * Pending output is flushed first so it is not mixed with the mode
+     * sequences. The terminal is restored by crtcooked(), the destructor,
+     * or at exit. While input is attached, crtflush() decodes keys between
+     * the pieces of a large frame.
+     *
+     * @param uModes INPUT_T reporting modes to turn on.
+     * @param fd The descriptor to read; standard input by default.
+     * @return False if the terminal could not be switched.
+     */
+    bool crtraw(unsigned uModes = INPUT_MOUSE | INPUT_PASTE,int fd = 0);
+    /**
+     * @brief Restores the terminal settings crtraw() changed.
+     *
+     * Keys already decoded can still be read with crtgetkey().
+     */
+    void crtcooked();
+    /**
+     * @brief Takes the next decoded key without waiting.
+     *
+     * @param key Receives the key.
+     * @return False if none is waiting.
+     */
+    bool crtgetkey(crtkey & key);
+    /**
+     * @brief Waits for a key.
+     *
+     * Also returns early when a signal such as SIGWINCH arrives, so the
+     * caller can check crtpoll_resize().
+     *
+     * @param iTimeoutMs Longest wait in milliseconds; negative waits forever.
+     * @return True if a key is waiting.
+     */
+    bool crtwaitkey(int iTimeoutMs);
+    /**
+     * @brief Retrieves the input decoder, creating a detached one if needed.
+     *
+     * For feeding bytes directly or installing a key hook.
+     */
+    crtinput * crtgetinput();
     /**
      * Sets the text style, foreground color, and background color for the terminal output.
      *
+     * The binding remembers the attributes it last set and emits only the
+     * SGR parameters that differ, or nothing when the style is unchanged.
+     *
      * @param mode Specifies the text style mode (e.g., bold, underline, italic).
      *             It is represented by the MODE_T enum.
      * @param fg   Specifies the foreground color of the text.
@@ -121,6 +419,192 @@ public:
      *             It is represented by the BG_COLORS_T enum.
      */
     void crtstyle(MODE_T mode,FG_COLORS_T fg,BG_COLORS_T bg);
+    /**
+     * Sets the text style with colors from the xterm 256-color palette.
+     *
+     * Without CAP_256 each color falls back to the nearest of the eight
+     * ANSI colors.
+     *
+     * @param mode The text mode.
+     * @param fg Foreground palette index.
+     * @param bg Background palette index.
+     */
+    void crtstyle_256(MODE_T mode,uint8_t fg,uint8_t bg);
+    /**
+     * Sets the text style with 24-bit colors.
+     *
+     * With CAP_RGB the colors are sent exactly. Otherwise they are reduced
+     * to 15 bits and mapped through a precomputed table to the nearest
+     * palette entry (CAP_256) or ANSI color, so a frame with thousands of
+     * distinct colors costs one table load per color.
+     *
+     * @param mode The text mode.
+     * @param fg Foreground color, 0xRRGGBB (see crtrgb()).
+     * @param bg Background color, 0xRRGGBB.
+     */
+    void crtstyle_rgb(MODE_T mode,uint32_t fg,uint32_t bg);
+    /**
+     * @brief Finds the xterm palette entry nearest to a 24-bit color.
+     *
+     * Searches the 6x6x6 color cube and the gray ramp (indices 16 to 255);
+     * the 16 system colors vary between terminals and are not used.
+     *
+     * @param rgb The color, 0xRRGGBB.
+     * @return The palette index.
+     */
+    static uint8_t crtpalette_index(uint32_t rgb);
+    /**
+     * @brief Forgets the remembered terminal attributes and cursor position.
+     *
+     * Call this after anything outside crtbind has written to the terminal,
+     * so the next crtstyle() re-establishes the full style and the next
+     * crtlc() uses absolute positioning.
+     */
+    void crtinvalidate();
+    /**
+     * @brief Takes over another instance's capabilities, screen size and
+     * newline mode, and forgets style and cursor.
+     *
+     * Used to set up side encoders (such as surface bands) whose output
+     * is later spliced in with crtappend().
+     *
+     * @param other The instance to copy the settings from.
+     */
+    void crtmatch(const crtbind & other);
+    /**
+     * @brief Moves another instance's pending bytes to the end of this frame.
+     *
+     * If it had any bytes, its style and cursor state become this one's, as
+     * though the bytes had been emitted here. Its buffer is left empty.
+     *
+     * @param other The instance whose frame is taken.
+     */
+    void crtappend(crtbind & other);
+    /**
+     * @brief Copies another instance's pending bytes to the end of this frame.
+     *
+     * Like crtappend(), but the other instance keeps its bytes, so a frame
+     * encoded once can be replayed many times (see window::render()).
+     *
+     * @param other The instance whose frame is copied.
+     */
+    void crtreplay(const crtbind & other);
+    /**
+     * @brief Drops the pending bytes without delivering them.
+     */
+    void crtdiscard();
+    /**
+     * Appends raw bytes (glyphs, text or escape sequences) to the frame buffer.
+     *
+     * Nothing is written to the terminal until crtflush() is called. The
+     * cursor position is advanced by one column per code point and follows
+     * CR, LF and backspace; any other control byte makes it unknown.
+     *
+     * @param ssBytes The bytes to append to the pending frame.
+     */
+    void crtputs(std::string_view ssBytes);
+    /**
+     * Appends printable bytes whose display width is already known.
+     *
+     * Skips the per-byte cursor tracking of crtputs(); used for pre-encoded
+     * glyph runs. The bytes must not contain control characters.
+     *
+     * @param ssBytes The bytes to append.
+     * @param iCells The number of columns they occupy.
+     */
+    void crtputcells(std::string_view ssBytes,int iCells);
+    /**
+     * Appends the same byte sequence to the frame buffer several times.
+     *
+     * Used for border runs, where a single glyph is repeated once per
+     * column. With CAP_REP enabled and a single glyph to repeat, the glyph
+     * is sent once followed by a REP sequence whenever that is shorter.
+     *
+     * @param ssBytes The bytes to repeat (typically one UTF-8 glyph).
+     * @param iCount  The number of repetitions; values below one append nothing.
+     */
+    void crtrepeat(std::string_view ssBytes,int iCount);
+    /**
+     * Writes iCount blank columns and leaves the cursor after them.
+     *
+     * Uses the shortest of plain spaces, a space plus REP (CAP_REP), or ECH
+     * followed by a cursor move (CAP_ECH).
+     *
+     * @param iCount The number of blank columns.
+     */
+    void crtpad(int iCount);
+    /**
+     * @brief Enables a set of optional terminal capabilities.
+     *
+     * @param uCaps A combination of CAPS_T flags.
+     */
+    void crtsetcaps(unsigned uCaps);
+    /**
+     * @brief Retrieves the enabled terminal capabilities.
+     *
+     * @return The CAPS_T flags in effect.
+     */
+    unsigned crtcaps();
+    /**
+     * @brief Guesses the capabilities of the terminal named by $TERM.
+     *
+     * @return CAPS_T flags for well-known terminal families, 0 otherwise;
+     * CAP_256 and CAP_RGB also follow a "256color" $TERM and $COLORTERM.
+     */
+    static unsigned crtcaps_from_env();
+    /**
+     * @brief Hands the pending frame to the sink in one block.
+     *
+     * With the default sink this is a single write(2) to standard output,
+     * retried only on partial writes and EINTR. The buffer is then emptied,
+     * keeping its capacity for the next frame.
+     *
+     * While input is attached (see crtraw()) a frame larger than
+     * FLUSH_CHUNK goes out in pieces of that size instead, and input is
+     * decoded between them.
+     */
+    void crtflush();
+    /**
+     * @brief Shows or hides the cursor ("CSI ? 25 h/l").
+     *
+     * Use this rather than writing the sequence, so that end_frame() puts
+     * the cursor back in the state the application chose.
+     *
+     * @param bVisible True to show the cursor.
+     */
+    void crtsetcursor(bool bVisible);
+    /**
+     * @brief Tells whether the cursor is shown.
+     */
+    bool crtcursor();
+    /**
+     * @brief Opens a frame transaction.
+     *
+     * Output is staged until the matching end_frame(); crtflush() calls in
+     * between are deferred. Transactions nest, and only the outermost one
+     * commits.
+     */
+    void begin_frame();
+    /**
+     * @brief Commits the frame transaction opened by begin_frame().
+     *
+     * The cursor is hidden while a non-empty frame is drawn and then put
+     * back as crtsetcursor() left it; with CAP_SYNC the frame is also
+     * wrapped in synchronized-output mode. It is then flushed in one block
+     * so the terminal shows it all at once.
+     */
+    void end_frame();
+    /**
+     * @brief Tells whether a frame transaction is open.
+     */
+    bool in_frame();
+    /**
+     * @brief Destructor for the crtbind class.
+     *
+     * Commits an open frame transaction and flushes any output still
+     * pending in the frame buffer.
+     */
+    ~crtbind();
 };
 
 
@@ -0,0 +1,644 @@
+///////////////////////////////////////////////////////////////////////////////
+// /home/doug/CLionProjects/semigraphics/crtinput.cpp 2026/10/17 19:30 dwg - //
+// Copyright (c) 2021-2026 Douglas Wade Goodall. All Rights Reserved.        //
+///////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <poll.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include "crtinput.h"
+
+/**
+ * @brief Decoder states.
+ */
+enum PARSE_T : uint8_t {
+    P_GROUND,       // between keys
+    P_ESC,          // after ESC
+    P_CSI,          // after ESC [
+    P_SS3,          // after ESC O
+    P_UTF8_1,       // one UTF-8 continuation byte to go
+    P_UTF8_2,       // two to go
+    P_UTF8_3,       // three to go
+    P_X10,          // reading the three bytes of an X10 mouse report
+    P_COUNT
+};
+
+/**
+ * @brief What the decoder does with a byte, before moving to the next state.
+ */
+enum ACTION_T : uint8_t {
+    A_IGNORE,       // nothing
+    A_CHAR,         // printable ASCII
+    A_C0,           // control character
+    A_ESC,          // ESC; a second one reports the first as KEY_ESCAPE
+    A_ALT,          // a key after ESC: Alt+key
+    A_START,        // begin a CSI or SS3 sequence
+    A_PARAM,        // parameter digit
+    A_SEP,          // parameter separator
+    A_MARK,         // private marker
+    A_CSI,          // CSI final byte
+    A_SS3,          // SS3 final byte
+    A_LEAD,         // UTF-8 lead byte
+    A_CONT,         // UTF-8 continuation byte
+    A_LAST,         // last UTF-8 continuation byte
+    A_BAD,          // malformed UTF-8: U+FFFD, and the byte is looked at again
+    A_X10           // X10 mouse report byte
+};
+
+/**
+ * @brief For each state and byte, the action in the upper four bits and the
+ * next state in the lower four.
+ */
+struct parsetable {
+    uint8_t op[P_COUNT][256];
+};
+
+/**
+ * @brief Builds the decoder table at compile time.
+ */
+static constexpr parsetable make_parsetable() {
+    parsetable t{};
+    auto set = [&](int state,int lo,int hi,ACTION_T a,PARSE_T next) {
+        for (int ch = lo; ch <= hi; ch++) {
+            t.op[state][ch] = static_cast<uint8_t>(a << 4 | next);
+        }
+    };
+    set(P_GROUND,0x00,0x1F,A_C0,P_GROUND);
+    set(P_GROUND,0x1B,0x1B,A_ESC,P_ESC);
+    set(P_GROUND,0x20,0x7E,A_CHAR,P_GROUND);
+    set(P_GROUND,0x7F,0x7F,A_C0,P_GROUND);
+    set(P_GROUND,0x80,0xFF,A_BAD,P_GROUND);
+    set(P_GROUND,0xC2,0xDF,A_LEAD,P_UTF8_1);
+    set(P_GROUND,0xE0,0xEF,A_LEAD,P_UTF8_2);
+    set(P_GROUND,0xF0,0xF4,A_LEAD,P_UTF8_3);
+
+    set(P_ESC,0x00,0xFF,A_ALT,P_GROUND);
+    set(P_ESC,0x1B,0x1B,A_ESC,P_ESC);
+    set(P_ESC,'[','[',A_START,P_CSI);
+    set(P_ESC,'O','O',A_START,P_SS3);
+
+    set(P_CSI,0x00,0x1F,A_IGNORE,P_CSI);
+    set(P_CSI,0x18,0x18,A_IGNORE,P_GROUND);     // CAN and SUB cancel
+    set(P_CSI,0x1A,0x1A,A_IGNORE,P_GROUND);
+    set(P_CSI,0x1B,0x1B,A_ESC,P_ESC);
+    set(P_CSI,0x20,0x2F,A_IGNORE,P_CSI);        // intermediates
+    set(P_CSI,'0','9',A_PARAM,P_CSI);
+    set(P_CSI,':',';',A_SEP,P_CSI);
+    set(P_CSI,'<','?',A_MARK,P_CSI);
+    set(P_CSI,0x40,0x7E,A_CSI,P_GROUND);
+    set(P_CSI,0x7F,0xFF,A_IGNORE,P_GROUND);
+
+    set(P_SS3,0x00,0xFF,A_IGNORE,P_GROUND);
+    set(P_SS3,0x1B,0x1B,A_ESC,P_ESC);
+    set(P_SS3,'0','9',A_PARAM,P_SS3);
+    set(P_SS3,0x40,0x7E,A_SS3,P_GROUND);
+
+    set(P_UTF8_1,0x00,0xFF,A_BAD,P_GROUND);
+    set(P_UTF8_1,0x80,0xBF,A_LAST,P_GROUND);
+    set(P_UTF8_2,0x00,0xFF,A_BAD,P_GROUND);
+    set(P_UTF8_2,0x80,0xBF,A_CONT,P_UTF8_1);
+    set(P_UTF8_3,0x00,0xFF,A_BAD,P_GROUND);
+    set(P_UTF8_3,0x80,0xBF,A_CONT,P_UTF8_2);
+
+    set(P_X10,0x00,0xFF,A_X10,P_X10);
+    return t;
+}
+
+static constexpr parsetable s_parse = make_parsetable();
+
+/**
+ * @brief Keys for the codes of "CSI code ~", indexed by code; KEY_NONE
+ * where the code means nothing (200 and 201, paste, are handled apart).
+ */
+static constexpr uint16_t s_tilde[] = {
+    KEY_NONE,KEY_HOME,KEY_INSERT,KEY_DELETE,KEY_END,KEY_PGUP,KEY_PGDN,KEY_HOME,     // 0-7
+    KEY_END,KEY_NONE,KEY_NONE,KEY_F1,KEY_F1+1,KEY_F1+2,KEY_F1+3,KEY_F1+4,          // 8-15
+    KEY_NONE,KEY_F1+5,KEY_F1+6,KEY_F1+7,KEY_F1+8,KEY_F1+9,KEY_NONE,KEY_F1+10,      // 16-23
+    KEY_F12                                                                         // 24
+};
+
+/**
+ * @brief Keys for the final bytes shared by CSI and SS3 ('A' to 'S'); 'M',
+ * keypad Enter, is only taken from SS3.
+ */
+static constexpr uint16_t s_final[] = {
+    KEY_UP,KEY_DOWN,KEY_RIGHT,KEY_LEFT,KEY_NONE,KEY_END,KEY_NONE,KEY_HOME,         // A-H
+    KEY_NONE,KEY_NONE,KEY_NONE,KEY_NONE,KEY_ENTER,KEY_NONE,KEY_NONE,KEY_F1,        // I-P
+    KEY_F1+1,KEY_F1+2,KEY_F1+3                                                      // Q-S
+};
+
+/**
+ * @brief Reads the steady clock in nanoseconds.
+ */
+static int64_t now_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * @brief The terminal in raw mode and its settings before; one per process.
+ */
+static struct termios s_saved;
+static int s_iRawFd = -1;
+static unsigned s_uModes = 0;
+
+/**
+ * @brief Writes a reporting-mode sequence to standard output.
+ */
+static void put_modes(std::string_view ssSeq) {
+    while (!ssSeq.empty()) {
+        ssize_t iWritten = ::write(STDOUT_FILENO,ssSeq.data(),ssSeq.size());
+        if (iWritten <= 0) {
+            return;
+        }
+        ssSeq.remove_prefix(iWritten);
+    }
+}
+
+/**
+ * @brief Turns the reporting modes off and restores the saved settings.
+ *
+ * Registered with atexit() so that a program leaving without detaching
+ * does not leave the shell in raw mode.
+ */
+static void restore_tty() {
+    if (s_iRawFd < 0) {
+        return;
+    }
+    if (s_uModes & INPUT_PASTE) {
+        put_modes("\x1B[?2004l");
+    }
+    if (s_uModes & INPUT_MOUSE) {
+        put_modes("\x1B[?1006l\x1B[?1002l\x1B[?1000l");
+    }
+    ::tcsetattr(s_iRawFd,TCSANOW,&s_saved);
+    s_iRawFd = -1;
+    s_uModes = 0;
+}
+
+/**
+ * @brief Constructs a detached decoder.
+ */
+crtinput::crtinput() {
+    m_fd = -1;
+    m_bRaw = false;
+    m_state = P_GROUND;
+    m_bPaste = false;
+    m_cMark = 0;
+    m_iParams = 0;
+    m_params[0] = 0;
+    m_cp = 0;
+    m_iX10 = 0;
+    m_iEscNs = 0;
+    m_iHead = 0;
+    m_iTail = 0;
+    m_iDropped = 0;
+    m_pfnHook = nullptr;
+    m_pHookArg = nullptr;
+}
+
+/**
+ * @brief Restores the terminal.
+ */
+crtinput::~crtinput() {
+    detach();
+}
+
+/**
+ * @brief Attaches a descriptor, making a terminal raw.
+ *
+ * Only one terminal is raw at a time; attaching a second one fails. A
+ * descriptor that is not a terminal (a pipe, a file) is read as it is.
+ *
+ * @param fd The descriptor.
+ * @param uModes INPUT_T bits; ignored for a descriptor that is not a terminal.
+ * @return True if the descriptor is attached.
+ */
+bool crtinput::attach(int fd,unsigned uModes) {
+    detach();
+    if (fd < 0) {
+        return false;
+    }
+    if (::isatty(fd)) {
+        struct termios t;
+        if (s_iRawFd >= 0 || ::tcgetattr(fd,&t) != 0) {
+            return false;
+        }
+        s_saved = t;
+        t.c_iflag &= ~(IGNBRK | BRKINT | PARMRK | ISTRIP | INLCR | IGNCR | ICRNL | IXON);
+        t.c_lflag &= ~(ECHO | ECHONL | ICANON | ISIG | IEXTEN);
+        t.c_cflag = (t.c_cflag & ~(CSIZE | PARENB)) | CS8;
+        t.c_cc[VMIN] = 0;
+        t.c_cc[VTIME] = 0;
+        if (::tcsetattr(fd,TCSANOW,&t) != 0) {
+            return false;
+        }
+        static bool s_bAtExit = std::atexit(restore_tty) == 0;
+        (void)s_bAtExit;
+        s_iRawFd = fd;
+        s_uModes = uModes;
+        if (uModes & INPUT_MOUSE) {
+            put_modes("\x1B[?1000h\x1B[?1002h\x1B[?1006h");
+        }
+        if (uModes & INPUT_PASTE) {
+            put_modes("\x1B[?2004h");
+        }
+        m_bRaw = true;
+    }
+    m_fd = fd;
+    m_state = P_GROUND;
+    m_bPaste = false;
+    return true;
+}
+
+/**
+ * @brief Restores the terminal if it was made raw, and detaches.
+ *
+ * Keys already decoded stay queued.
+ */
+void crtinput::detach() {
+    if (m_bRaw) {
+        restore_tty();
+        m_bRaw = false;
+    }
+    m_fd = -1;
+}
+
+/**
+ * @brief Installs the key hook.
+ *
+ * @param pfn The hook, or nullptr.
+ * @param pArg Passed to the hook.
+ */
+void crtinput::set_hook(keyhook pfn,void * pArg) {
+    m_pfnHook = pfn;
+    m_pHookArg = pArg;
+}
+
+/**
+ * @brief Reports a key and queues it; a full ring drops it.
+ *
+ * @param key The key; marked MOD_PASTE inside a bracketed paste.
+ */
+void crtinput::push(crtkey key) {
+    if (m_bPaste) {
+        key.mods |= MOD_PASTE;
+    }
+    if (m_pfnHook) {
+        m_pfnHook(key,m_pHookArg);
+    }
+    if (m_iTail - m_iHead >= RING) {
+        m_iDropped++;
+        return;
+    }
+    m_ring[m_iTail++ % RING] = key;
+}
+
+/**
+ * @brief Pushes a keyboard key.
+ *
+ * @param key KEY_T value.
+ * @param mods MOD_T bits.
+ * @param cp The character, for KEY_CHAR.
+ */
+void crtinput::emit(uint16_t key,uint8_t mods,char32_t cp) {
+    push(crtkey{key,mods,0,cp,0,0});
+}
+
+/**
+ * @brief Decodes a control character.
+ *
+ * CR and LF are Enter, BS and DEL Backspace; the others are Ctrl plus the
+ * letter or symbol they are typed with.
+ *
+ * @param ch The byte, below 0x20 or 0x7F.
+ * @param mods MOD_ALT when it followed an ESC.
+ */
+void crtinput::control(unsigned char ch,uint8_t mods) {
+    switch (ch) {
+        case '\r':
+        case '\n': emit(KEY_ENTER,mods); return;
+        case '\t': emit(KEY_TAB,mods); return;
+        case 0x08:
+        case 0x7F: emit(KEY_BACKSPACE,mods); return;
+        case 0x1B: emit(KEY_ESCAPE,mods); return;
+        case 0x00: emit(KEY_CHAR,mods | MOD_CTRL,' '); return;
+        default:
+            emit(KEY_CHAR,mods | MOD_CTRL,ch <= 0x1A ? ch - 1 + 'a' : ch + 0x40);
+            return;
+    }
+}
+
+/**
+ * @brief Decodes "CSI code ~": editing keys, F1-F12 and paste markers.
+ *
+ * @param uCode The first parameter.
+ * @param mods Modifier bits.
+ */
+void crtinput::tilde(unsigned uCode,uint8_t mods) {
+    if (uCode == 200) {
+        emit(KEY_PASTE_BEGIN);
+        m_bPaste = true;
+    } else if (uCode == 201) {
+        m_bPaste = false;
+        emit(KEY_PASTE_END);
+    } else if (uCode < std::size(s_tilde) && s_tilde[uCode] != KEY_NONE) {
+        emit(s_tilde[uCode],mods);
+    }
+}
+
+/**
+ * @brief Decodes a CSI sequence.
+ *
+ * Modifiers come in the second parameter as 1 + the xterm bits. Replies to
+ * queries (private markers other than '<') are dropped.
+ *
+ * @param chFinal The final byte.
+ */
+void crtinput::csi(unsigned char chFinal) {
+    unsigned p0 = m_iParams > 0 ? m_params[0] : 0;
+    unsigned p1 = m_iParams > 1 ? m_params[1] : 0;
+    uint8_t mods = p1 > 1 ? (p1 - 1) & (MOD_SHIFT | MOD_ALT | MOD_CTRL) : 0;
+    if (m_cMark == '<') {
+        if ((chFinal == 'M' || chFinal == 'm') && m_iParams >= 3) {
+            mouse(p0,m_params[1],m_params[2],chFinal == 'm');
+        }
+        return;
+    }
+    if (m_cMark) {
+        return;
+    }
+    if (chFinal == '~') {
+        tilde(p0,mods);
+    } else if (chFinal == 'M') {
+        // X10 mouse when bare; keypad Enter is SS3 only, so "CSI ... M"
+        // with parameters (urxvt mouse, stray replies) is dropped
+        if (m_iParams == 0) {
+            m_state = P_X10;
+            m_iX10 = 0;
+        }
+    } else if (chFinal == 'Z') {
+        emit(KEY_TAB,MOD_SHIFT);
+    } else if (chFinal == 'u') {
+        // "CSI code ; mods u", the fixterms/kitty form
+        switch (p0) {
+            case 13:  emit(KEY_ENTER,mods); break;
+            case 9:   emit(KEY_TAB,mods); break;
+            case 27:  emit(KEY_ESCAPE,mods); break;
+            case 127: emit(KEY_BACKSPACE,mods); break;
+            default:  emit(KEY_CHAR,mods,p0); break;
+        }
+    } else if (chFinal >= 'A' && chFinal <= 'S' && s_final[chFinal - 'A'] != KEY_NONE) {
+        emit(s_final[chFinal - 'A'],mods);
+    }
+}
+
+/**
+ * @brief Decodes an SS3 sequence: cursor keys in application mode, F1-F4
+ * and keypad Enter; a digit before the final byte carries modifiers.
+ *
+ * @param chFinal The final byte.
+ */
+void crtinput::ss3(unsigned char chFinal) {
+    unsigned p0 = m_iParams > 0 ? m_params[0] : 0;
+    uint8_t mods = p0 > 1 ? (p0 - 1) & (MOD_SHIFT | MOD_ALT | MOD_CTRL) : 0;
+    if (chFinal >= 'A' && chFinal <= 'S' && s_final[chFinal - 'A'] != KEY_NONE) {
+        emit(s_final[chFinal - 'A'],mods);
+    }
+}
+
+/**
+ * @brief Pushes a mouse event.
+ *
+ * @param uCode The xterm button code: button in bits 0-1, Shift, Alt and
+ * Ctrl in bits 2-4, motion in bit 5, wheel in bit 6.
+ * @param iCol 1-based column.
+ * @param iLine 1-based line.
+ * @param bRelease True for a release.
+ */
+void crtinput::mouse(unsigned uCode,int iCol,int iLine,bool bRelease) {
+    uint8_t mods = (uCode >> 2) & (MOD_SHIFT | MOD_ALT | MOD_CTRL);
+    uint8_t button = uCode & 3;
+    uint16_t key;
+    if (uCode & 64) {
+        if (button > 1) {
+            return;         // horizontal wheel
+        }
+        key = button == 0 ? KEY_WHEEL_UP : KEY_WHEEL_DOWN;
+        button = 3;
+    } else if (bRelease) {
+        key = KEY_MOUSE_RELEASE;
+    } else if (uCode & 32) {
+        key = KEY_MOUSE_MOVE;
+    } else {
+        key = button == 3 ? KEY_MOUSE_RELEASE : KEY_MOUSE_PRESS;   // X10 reports releases as button 3
+    }
+    push(crtkey{key,mods,button,0,static_cast<int16_t>(std::min(iLine,0x7FFF)),
+                static_cast<int16_t>(std::min(iCol,0x7FFF))});
+}
+
+/**
+ * @brief Decodes bytes.
+ *
+ * One table lookup per byte picks the action and the next state; the
+ * action runs with m_state already advanced. A_BAD and an ESC followed by
+ * a non-ASCII byte look at the same byte again in P_GROUND.
+ *
+ * @param ssBytes The bytes.
+ */
+void crtinput::feed(std::string_view ssBytes) {
+    const unsigned char * p = reinterpret_cast<const unsigned char *>(ssBytes.data());
+    size_t n = ssBytes.size();
+    size_t i = 0;
+    while (i < n) {
+        unsigned char ch = p[i];
+        uint8_t prev = m_state;
+        uint8_t op = s_parse.op[prev][ch];
+        m_state = op & 0x0F;
+        bool bAgain = false;
+        switch (op >> 4) {
+            case A_IGNORE:
+                break;
+            case A_CHAR:
+                emit(KEY_CHAR,0,ch);
+                break;
+            case A_C0:
+                control(ch,0);
+                break;
+            case A_ESC:
+                if (prev == P_ESC) {
+                    emit(KEY_ESCAPE);
+                }
+                m_iEscNs = now_ns();
+                break;
+            case A_ALT:
+                if (ch >= 0x80) {
+                    emit(KEY_ESCAPE);
+                    bAgain = true;
+                } else if (ch < 0x20 || ch == 0x7F) {
+                    control(ch,MOD_ALT);
+                } else {
+                    emit(KEY_CHAR,MOD_ALT,ch);
+                }
+                break;
+            case A_START:
+                m_iParams = 0;
+                m_params[0] = 0;
+                m_cMark = 0;
+                break;
+            case A_PARAM:
+                if (m_iParams == 0) {
+                    m_iParams = 1;
+                    m_params[0] = 0;
+                }
+                m_params[m_iParams - 1] = std::min(m_params[m_iParams - 1] * 10 + (ch - '0'),0xFFFF);
+                break;
+            case A_SEP:
+                if (m_iParams == 0) {
+                    m_iParams = 1;
+                    m_params[0] = 0;
+                }
+                if (m_iParams < std::size(m_params)) {
+                    m_params[m_iParams++] = 0;
+                }
+                break;
+            case A_MARK:
+                m_cMark = ch;
+                break;
+            case A_CSI:
+                csi(ch);
+                break;
+            case A_SS3:
+                ss3(ch);
+                break;
+            case A_LEAD:
+                m_cp = ch & (m_state == P_UTF8_1 ? 0x1F : m_state == P_UTF8_2 ? 0x0F : 0x07);
+                break;
+            case A_CONT:
+                m_cp = m_cp << 6 | (ch & 0x3F);
+                break;
+            case A_LAST:
+                m_cp = m_cp << 6 | (ch & 0x3F);
+                emit(KEY_CHAR,0,(m_cp >= 0xD800 && m_cp <= 0xDFFF) || m_cp > 0x10FFFF ? 0xFFFD : m_cp);
+                break;
+            case A_BAD:
+                emit(KEY_CHAR,0,0xFFFD);
+                bAgain = prev != P_GROUND;
+                break;
+            case A_X10:
+                m_x10[m_iX10++] = ch;
+                if (m_iX10 == 3) {
+                    m_state = P_GROUND;
+                    unsigned uCode = (m_x10[0] - 32) & 0xFF;
+                    mouse(uCode,m_x10[1] - 32,m_x10[2] - 32,false);
+                }
+                break;
+        }
+        if (!bAgain) {
+            i++;
+        }
+    }
+}
+
+/**
+ * @brief Reports a lone ESC once nothing has followed it for ESC_DELAY_MS.
+ */
+void crtinput::expire() {
+    if (m_state == P_ESC && now_ns() - m_iEscNs >= int64_t(ESC_DELAY_MS) * 1000000) {
+        m_state = P_GROUND;
+        emit(KEY_ESCAPE);
+    }
+}
+
+/**
+ * @brief Reads and decodes the input available now.
+ *
+ * poll(2) with a zero timeout guards every read(2), so the call returns
+ * at once when nothing is there, whatever the descriptor's flags. The
+ * number of reads per call is bounded so that a flood of input cannot
+ * hold up a caller pumping between output blocks. End of file or a
+ * hangup detaches the descriptor.
+ *
+ * @return Number of keys waiting.
+ */
+size_t crtinput::pump() {
+    if (m_fd >= 0) {
+        char buf[1024];
+        for (int iReads = 0; iReads < 16 && m_fd >= 0; iReads++) {
+            struct pollfd pfd{m_fd,POLLIN,0};
+            if (::poll(&pfd,1,0) <= 0) {
+                break;
+            }
+            ssize_t iRead = pfd.revents & POLLIN ? ::read(m_fd,buf,sizeof(buf)) : 0;
+            if (iRead < 0) {
+                break;
+            }
+            if (iRead == 0) {
+                detach();       // end of file or hangup: nothing more will come
+                break;
+            }
+            feed(std::string_view(buf,iRead));
+        }
+    }
+    expire();
+    return pending();
+}
+
+/**
+ * @brief Waits for a key.
+ *
+ * @param iTimeoutMs Longest wait in milliseconds; negative waits forever.
+ * @return True if a key is waiting.
+ */
+bool crtinput::wait(int iTimeoutMs) {
+    int64_t iEnd = now_ns() + int64_t(std::max(iTimeoutMs,0)) * 1000000;
+    auto ms_until = [](int64_t iNow,int64_t iThen) {
+        return static_cast<int>(std::max<int64_t>((iThen - iNow + 999999) / 1000000,0));
+    };
+    for (;;) {
+        if (pump() > 0) {
+            return true;
+        }
+        int64_t iNow = now_ns();
+        int iWait = -1;
+        if (iTimeoutMs >= 0) {
+            if (iNow >= iEnd) {
+                return false;
+            }
+            iWait = ms_until(iNow,iEnd);
+        }
+        if (m_state == P_ESC) {
+            int iEsc = ms_until(iNow,m_iEscNs + int64_t(ESC_DELAY_MS) * 1000000);
+            iWait = iWait < 0 ? iEsc : std::min(iWait,iEsc);
+        }
+        if (m_fd < 0 && iWait < 0) {
+            return false;       // nothing can arrive
+        }
+        struct pollfd pfd{m_fd,POLLIN,0};
+        if (::poll(&pfd,1,iWait) < 0) {
+            return pump() > 0;  // interrupted, e.g. by SIGWINCH
+        }
+    }
+}
+
+/**
+ * @brief Takes the oldest key.
+ *
+ * @param key Receives it.
+ * @return False if the ring is empty.
+ */
+bool crtinput::pop(crtkey & key) {
+    if (m_iHead == m_iTail) {
+        return false;
+    }
+    key = m_ring[m_iHead++ % RING];
+    return true;
+}
+
+////////////////////////
+// eof - crtinput.cpp //
+////////////////////////
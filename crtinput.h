@@ -0,0 +1,287 @@
+///////////////////////////////////////////////////////////////////////////////
+// /home/doug/CLionProjects/semigraphics/crtinput.h  2026/10/17 19:30 dwg - //
+// Copyright (c) 2021-2026 Douglas Wade Goodall. All Rights Reserved.        //
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef CRTINPUT_H
+#define CRTINPUT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+/**
+ * @enum KEY_T
+ * @brief What a decoded input event is.
+ */
+enum KEY_T : uint16_t {
+    KEY_NONE,
+    KEY_CHAR,           // a character, in crtkey::cp; Ctrl-A..Ctrl-Z come as 'a'..'z' with MOD_CTRL
+    KEY_ENTER,
+    KEY_TAB,
+    KEY_BACKSPACE,
+    KEY_ESCAPE,
+    KEY_UP,
+    KEY_DOWN,
+    KEY_RIGHT,
+    KEY_LEFT,
+    KEY_HOME,
+    KEY_END,
+    KEY_INSERT,
+    KEY_DELETE,
+    KEY_PGUP,
+    KEY_PGDN,
+    KEY_F1,             // KEY_F1 + n - 1 is Fn, up to F12
+    KEY_F12 = KEY_F1 + 11,
+    KEY_MOUSE_PRESS,    // crtkey::button, line and col are set for the mouse events
+    KEY_MOUSE_RELEASE,
+    KEY_MOUSE_MOVE,     // motion, with a button held unless button is 3
+    KEY_WHEEL_UP,
+    KEY_WHEEL_DOWN,
+    KEY_PASTE_BEGIN,    // bracketed paste: the keys up to KEY_PASTE_END carry MOD_PASTE
+    KEY_PASTE_END
+};
+
+/**
+ * @enum MOD_T
+ * @brief Modifier bits of a crtkey; the first three match xterm's encoding.
+ */
+enum MOD_T : uint8_t {
+    MOD_SHIFT = 0x01,
+    MOD_ALT   = 0x02,
+    MOD_CTRL  = 0x04,
+    MOD_PASTE = 0x08    // part of a bracketed paste, not typed
+};
+
+/**
+ * @enum INPUT_T
+ * @brief Terminal reporting modes crtbind::crtraw() can turn on.
+ */
+enum INPUT_T : unsigned {
+    INPUT_MOUSE = 0x01, // button presses, drags and the wheel, in SGR encoding (modes 1002, 1006)
+    INPUT_PASTE = 0x02  // bracketed paste (mode 2004)
+};
+
+/**
+ * @struct crtkey
+ * @brief One decoded key press, mouse report or paste marker.
+ */
+struct crtkey {
+    uint16_t key;       // KEY_T
+    uint8_t  mods;      // MOD_T bits
+    uint8_t  button;    // mouse: 0 left, 1 middle, 2 right, 3 none
+    char32_t cp;        // KEY_CHAR: the code point
+    int16_t  line;      // mouse: 1-based screen line
+    int16_t  col;       // mouse: 1-based screen column
+};
+
+/**
+ * @class crtinput
+ * @brief Reads a terminal in raw mode and decodes its input into crtkeys.
+ *
+ * Bytes go through a state machine driven by a 256-entry table per state:
+ * one lookup per byte gives the action and the next state, so plain keys,
+ * UTF-8, CSI and SS3 sequences (arrows, function keys, modifiers), SGR and
+ * X10 mouse reports and bracketed paste are decoded without branching on
+ * the byte itself. Parameters live in a fixed array and decoded keys in a
+ * fixed ring, so decoding never allocates.
+ *
+ * The descriptor is read only when poll(2) says it is readable, and a
+ * terminal is set to VMIN 0 / VTIME 0, so reads never block; O_NONBLOCK is
+ * not used because standard input usually shares its file description with
+ * standard output. A lone ESC is told from the start of a sequence by the
+ * ESC_DELAY_MS pause after it.
+ *
+ * Owned by crtbind, which pumps it between the blocks of a large frame so
+ * that keys are decoded, and handed to a hook, while the frame is flushed.
+ */
+class crtinput {
+public:
+    /**
+     * @brief Capacity of the key ring; keys beyond it are dropped and counted.
+     */
+    static constexpr unsigned RING = 256;
+    /**
+     * @brief How long an ESC with nothing after it waits before it is
+     * reported as KEY_ESCAPE.
+     */
+    static constexpr int ESC_DELAY_MS = 20;
+    /**
+     * @brief Called for each key as soon as it is decoded.
+     */
+    using keyhook = void (*)(const crtkey & key,void * pArg);
+
+private:
+    /**
+     * @brief The descriptor read, or -1 when detached.
+     */
+    int m_fd;
+    /**
+     * @brief True when attach() put m_fd in raw mode.
+     */
+    bool m_bRaw;
+    /**
+     * @brief Current state of the decoder (a PARSE_T value in crtinput.cpp).
+     */
+    uint8_t m_state;
+    /**
+     * @brief True between the bracketed paste markers.
+     */
+    bool m_bPaste;
+    /**
+     * @brief Private marker of the CSI sequence being read ('<', '?', ...).
+     */
+    char m_cMark;
+    /**
+     * @brief Number of CSI parameters started.
+     */
+    uint8_t m_iParams;
+    /**
+     * @brief CSI/SS3 parameters; extra ones are dropped.
+     */
+    uint16_t m_params[8];
+    /**
+     * @brief The UTF-8 character being assembled.
+     */
+    char32_t m_cp;
+    /**
+     * @brief Bytes of an X10 mouse report read so far, and the report.
+     */
+    uint8_t m_iX10;
+    uint8_t m_x10[3];
+    /**
+     * @brief When the pending ESC arrived, in steady-clock nanoseconds.
+     */
+    int64_t m_iEscNs;
+    /**
+     * @brief Decoded keys not yet taken; m_iHead and m_iTail count forever.
+     */
+    crtkey m_ring[RING];
+    unsigned m_iHead;
+    unsigned m_iTail;
+    /**
+     * @brief Keys lost because the ring was full.
+     */
+    uint64_t m_iDropped;
+    /**
+     * @brief Optional hook and its argument.
+     */
+    keyhook m_pfnHook;
+    void * m_pHookArg;
+
+    /**
+     * @brief Reports a key to the hook and queues it.
+     */
+    void push(crtkey key);
+    /**
+     * @brief Pushes a key that is not a mouse event.
+     */
+    void emit(uint16_t key,uint8_t mods = 0,char32_t cp = 0);
+    /**
+     * @brief Decodes a CSI sequence ending in '~'.
+     */
+    void tilde(unsigned uCode,uint8_t mods);
+    /**
+     * @brief Decodes a control character.
+     */
+    void control(unsigned char ch,uint8_t mods);
+    /**
+     * @brief Decodes a complete CSI sequence.
+     */
+    void csi(unsigned char chFinal);
+    /**
+     * @brief Decodes a complete SS3 sequence.
+     */
+    void ss3(unsigned char chFinal);
+    /**
+     * @brief Queues a mouse event from an xterm button code.
+     */
+    void mouse(unsigned uCode,int iCol,int iLine,bool bRelease);
+    /**
+     * @brief Reports a pending lone ESC once ESC_DELAY_MS has passed.
+     */
+    void expire();
+
+public:
+    /**
+     * @brief Constructs a detached decoder.
+     */
+    crtinput();
+    /**
+     * @brief Restores the terminal if this decoder put it in raw mode.
+     */
+    ~crtinput();
+    /**
+     * @brief Attaches a descriptor and, if it is a terminal, makes it raw.
+     *
+     * Echo, line editing, signal keys and CR translation are turned off
+     * (Ctrl-C arrives as a key); output processing is left alone. The
+     * original settings are restored by detach(), the destructor, or at
+     * exit. Reporting modes are written to standard output.
+     *
+     * @param fd The descriptor to read, usually STDIN_FILENO.
+     * @param uModes INPUT_T bits.
+     * @return False if fd is negative or its settings could not be changed.
+     */
+    bool attach(int fd,unsigned uModes);
+    /**
+     * @brief Restores the terminal and stops reading.
+     */
+    void detach();
+    /**
+     * @brief Retrieves the descriptor read, or -1.
+     */
+    int get_fd() const {
+        return m_fd;
+    }
+    /**
+     * @brief Decodes bytes as if they had been read.
+     *
+     * @param ssBytes The input bytes.
+     */
+    void feed(std::string_view ssBytes);
+    /**
+     * @brief Reads and decodes whatever input is available, without waiting.
+     *
+     * @return Number of keys waiting afterwards.
+     */
+    size_t pump();
+    /**
+     * @brief Waits until a key is decoded or the timeout passes.
+     *
+     * A pending lone ESC shortens the wait so it is reported on time. A
+     * signal (such as SIGWINCH) ends the wait early.
+     *
+     * @param iTimeoutMs Longest wait in milliseconds; negative waits forever.
+     * @return True if a key is waiting.
+     */
+    bool wait(int iTimeoutMs);
+    /**
+     * @brief Takes the oldest decoded key.
+     *
+     * @param key Receives the key.
+     * @return False if none is waiting.
+     */
+    bool pop(crtkey & key);
+    /**
+     * @brief Retrieves the number of keys waiting.
+     */
+    size_t pending() const {
+        return m_iTail - m_iHead;
+    }
+    /**
+     * @brief Retrieves the number of keys dropped on a full ring.
+     */
+    uint64_t get_dropped() const {
+        return m_iDropped;
+    }
+    /**
+     * @brief Installs a hook called for each decoded key, or removes it.
+     *
+     * @param pfn The hook, or nullptr.
+     * @param pArg Passed to the hook.
+     */
+    void set_hook(keyhook pfn,void * pArg);
+};
+
+#endif //CRTINPUT_H
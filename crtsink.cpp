@@ -0,0 +1,101 @@
+//////////////////////////////////////////////////////////////////////////////
+// /home/doug/CLionProjects/semigraphics/crtsink.cpp 2026/10/17 14:00 dwg - //
+// Copyright (c) 2021-2026 Douglas Wade Goodall. All Rights Reserved.       //
+//////////////////////////////////////////////////////////////////////////////
+
+#include <cerrno>
+#include <cstdio>
+#include <iostream>
+#include <unistd.h>
+
+#include "crtsink.h"
+
+/**
+ * @brief Constructs a sink for a descriptor.
+ *
+ * @param fd The descriptor to write to.
+ */
+fdsink::fdsink(int fd) {
+    m_fd = fd;
+}
+
+/**
+ * @brief Writes a block, retrying after signals and partial writes.
+ *
+ * @param pData The bytes.
+ * @param iSize Number of bytes.
+ * @return False if write(2) failed.
+ */
+bool fdsink::write(const char * pData, size_t iSize) {
+    if (m_fd == STDOUT_FILENO) {
+        std::cout.flush();
+    }
+    m_iBlocks++;
+    while (iSize > 0) {
+        ssize_t iWritten = ::write(m_fd,pData,iSize);
+        m_iWrites++;
+        if (iWritten < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        m_iBytes += iWritten;
+        pData += iWritten;
+        iSize -= iWritten;
+    }
+    return true;
+}
+
+/**
+ * @brief Constructs a sink for a stdio stream.
+ *
+ * @param pFile The stream to write to.
+ */
+filesink::filesink(FILE * pFile) {
+    m_pFile = pFile;
+}
+
+/**
+ * @brief Writes a block to the stream and flushes it.
+ *
+ * @param pData The bytes.
+ * @param iSize Number of bytes.
+ * @return False if the stream reported an error.
+ */
+bool filesink::write(const char * pData, size_t iSize) {
+    size_t iWritten = std::fwrite(pData,1,iSize,m_pFile);
+    m_iBytes += iWritten;
+    m_iBlocks++;
+    return iWritten == iSize && std::fflush(m_pFile) == 0;
+}
+
+/**
+ * @brief Appends a block to the buffer.
+ *
+ * @param pData The bytes.
+ * @param iSize Number of bytes.
+ * @return Always true.
+ */
+bool memsink::write(const char * pData, size_t iSize) {
+    m_ssData.append(pData,iSize);
+    m_iBytes += iSize;
+    m_iBlocks++;
+    return true;
+}
+
+/**
+ * @brief Counts a block and drops it.
+ *
+ * @param iSize Number of bytes.
+ * @return Always true.
+ */
+bool nullsink::write(const char *, size_t iSize) {
+    m_iBytes += iSize;
+    m_iBlocks++;
+    return true;
+}
+
+///////////////////////
+// eof - crtsink.cpp //
+///////////////////////
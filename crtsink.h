@@ -0,0 +1,153 @@
+////////////////////////////////////////////////////////////////////////////
+// /home/doug/CLionProjects/semigraphics/crtsink.h 2026/10/17 14:00 dwg - //
+// Copyright (c) 2021-2026 Douglas Wade Goodall. All Rights Reserved.     //
+////////////////////////////////////////////////////////////////////////////
+
+#ifndef CRTSINK_H
+#define CRTSINK_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <string_view>
+
+/**
+ * @class crtsink
+ * @brief Destination for the frames crtbind::crtflush() hands over.
+ *
+ * A sink receives each flushed frame as one block of bytes. Every sink
+ * counts the bytes and blocks it accepted, so that headless renders can
+ * be measured the same way whatever the destination.
+ */
+class crtsink {
+protected:
+    /**
+     * @brief Bytes accepted so far.
+     */
+    uint64_t m_iBytes = 0;
+    /**
+     * @brief Blocks (flushed frames) accepted so far.
+     */
+    uint64_t m_iBlocks = 0;
+
+public:
+    virtual ~crtsink() = default;
+    /**
+     * @brief Delivers one block of bytes.
+     *
+     * @param pData The bytes.
+     * @param iSize Number of bytes.
+     * @return False if the destination failed; the bytes may be partly lost.
+     */
+    virtual bool write(const char * pData,size_t iSize) = 0;
+    /**
+     * @brief Retrieves the number of bytes accepted.
+     */
+    uint64_t get_bytes() const { return m_iBytes; }
+    /**
+     * @brief Retrieves the number of blocks accepted.
+     */
+    uint64_t get_blocks() const { return m_iBlocks; }
+    /**
+     * @brief Retrieves the number of write calls made to the destination;
+     * one per block unless a sink knows better.
+     */
+    virtual uint64_t get_writes() const { return m_iBlocks; }
+    /**
+     * @brief Retrieves the descriptor written to, or -1 for a sink without
+     * one; lets crtbind::crtflush() wait for room and for input together.
+     */
+    virtual int get_fd() const { return -1; }
+};
+
+/**
+ * @class fdsink
+ * @brief Writes to a file descriptor: a terminal, pipe, socket or file.
+ *
+ * Each block goes out in one write(2) unless the kernel accepts it
+ * partially; EINTR is retried. The descriptor is not closed.
+ */
+class fdsink : public crtsink {
+    /**
+     * @brief The descriptor written to.
+     */
+    int m_fd;
+    /**
+     * @brief Number of write(2) calls made.
+     */
+    uint64_t m_iWrites = 0;
+
+public:
+    /**
+     * @brief Constructs a sink for a descriptor.
+     *
+     * @param fd The descriptor; std::cout is flushed ahead of each block when
+     * this is STDOUT_FILENO, so stream output keeps its place.
+     */
+    explicit fdsink(int fd);
+    bool write(const char * pData,size_t iSize) override;
+    /**
+     * @brief Retrieves the number of write(2) calls made.
+     */
+    uint64_t get_writes() const override { return m_iWrites; }
+    int get_fd() const override { return m_fd; }
+};
+
+/**
+ * @class filesink
+ * @brief Writes to a stdio stream and flushes it after each block.
+ *
+ * The stream is not closed.
+ */
+class filesink : public crtsink {
+    /**
+     * @brief The stream written to.
+     */
+    FILE * m_pFile;
+
+public:
+    /**
+     * @brief Constructs a sink for a stdio stream.
+     *
+     * @param pFile The stream, for example a popen() pipe to a pager.
+     */
+    explicit filesink(FILE * pFile);
+    bool write(const char * pData,size_t iSize) override;
+};
+
+/**
+ * @class memsink
+ * @brief Collects every block in a growable memory buffer.
+ *
+ * Useful for tests that compare rendered output and for measuring render
+ * cost without a terminal.
+ */
+class memsink : public crtsink {
+    /**
+     * @brief Everything written since the last clear().
+     */
+    std::string m_ssData;
+
+public:
+    bool write(const char * pData,size_t iSize) override;
+    /**
+     * @brief Retrieves the collected bytes.
+     */
+    std::string_view data() const { return m_ssData; }
+    /**
+     * @brief Discards the collected bytes, keeping the counters and capacity.
+     */
+    void clear() { m_ssData.clear(); }
+};
+
+/**
+ * @class nullsink
+ * @brief Discards everything, only counting bytes and blocks.
+ */
+class nullsink : public crtsink {
+public:
+    bool write(const char * pData,size_t iSize) override;
+};
+
+#endif //CRTSINK_H
@@ -3,7 +3,8 @@
 // Copyright (c) 2021-2025 Douglas Wade Goodall. All Rights Reserved.       //
 //////////////////////////////////////////////////////////////////////////////
 
-#include "std.h"
+#include <string>
+
 #include "semigraphics.h"
 #include "window.h"
 #include "crtbind.h"
@@ -38,8 +39,8 @@ semigraphics * gpSemiGr;
  *
  * Initializes global objects for terminal manipulation and semigraphics,
  * customizes the appearance of a window using Unicode characters, builds
- * and appends a copyright notice, sets the window title and dynamically
- * renders it to the terminal.
+ * and appends a copyright notice, sets the window title, renders it into
+ * the crtbind frame buffer and flushes the frame to the terminal.
  *
  * @return An integer representing the program's execution status.
  *         Returns 0 upon successful completion.
@@ -47,29 +48,27 @@ semigraphics * gpSemiGr;
 int main()
 {
     gpCrt = new crtbind();
+    gpCrt->crtsetcaps(crtbind::crtcaps_from_env());   // REP/ECH where known safe
     gpSemiGr = new semigraphics();
     window * pWin = new window();
 
     /**
      * @brief Configure window cosmetic characters
      *
-     * Sets up the visual appearance of the window using Unicode box-drawing
-     * characters for creating professional-looking borders and separators.
+     * Selects the rounded single-line theme, a constexpr glyph table built
+     * from the Unicode box-drawing macros in semigraphics.h.
      *
      * Character mapping:
-     * - SRUL: ┌ (top-left corner)
-     * - SRUR: ┐ (top-right corner)
-     * - SRLL: └ (bottom-left corner)
-     * - SRLR: ┘ (bottom-right corner)
+     * - SRUL: ╭ (top-left corner)
+     * - SRUR: ╮ (top-right corner)
+     * - SRLL: ╰ (bottom-left corner)
+     * - SRLR: ╯ (bottom-right corner)
      * - SVSR: ├ (vertical separator right)
      * - SVSL: ┤ (vertical separator left)
      * - SH:   ─ (horizontal line)
      * - SV:   │ (vertical line)
      */
-    gpSemiGr->cosmetics(
-        SRUL,     SRUR,  SRLL,    // Corner characters: ┌ ┐ └ ┘
-        SRLR,  SVSR,  SVSL,    // Right corner and separators
-        SH,    SV);               // Horizontal ─ and vertical │ lines
+    gpSemiGr->set_theme(&THEME_ROUNDED);
 
     /**
      * @brief Build copyright notice string
@@ -90,7 +89,9 @@ int main()
     pWin->set_title("MultiWare Engineering Framework Semigraphics Demo Ver 5.7.12.2");
     pWin->add_row(ssCopr);
 
+    gpCrt->begin_frame();   // stage the frame; the terminal shows it all at once
     pWin->render();
+    gpCrt->end_frame();     // hand the whole frame to the terminal in one write
 
     return 0;
 }
\ No newline at end of file
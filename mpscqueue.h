@@ -0,0 +1,126 @@
+///////////////////////////////////////////////////////////////////////////////
+// /home/doug/CLionProjects/semigraphics/mpscqueue.h  2026/10/17 12:40 dwg - //
+// Copyright (c) 2021-2026 Douglas Wade Goodall. All Rights Reserved.        //
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef MPSCQUEUE_H
+#define MPSCQUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+/**
+ * @class mpscqueue
+ * @brief Unbounded lock-free multi-producer, single-consumer FIFO queue.
+ *
+ * This is Dmitry Vyukov's linked-list queue. A push is one allocation and
+ * one atomic exchange, so producers never wait on each other or on the
+ * consumer. The consumer owns the tail and only follows next pointers.
+ * The list always holds one spent node: pop() moves the value out of the
+ * node after the tail, and that node becomes the new tail.
+ *
+ * Any thread may push(); only one thread at a time may pop() or drain().
+ * A push that is still in progress is invisible to the consumer until it
+ * completes. Items behind it wait, in order, for the next drain().
+ */
+template <class T>
+class mpscqueue {
+    /**
+     * @brief A list node; the value of the tail node is already consumed.
+     */
+    struct node {
+        std::atomic<node *> next{nullptr};
+        T value;
+    };
+
+    /**
+     * @brief Most recently pushed node; producers swap themselves in here.
+     */
+    alignas(64) std::atomic<node *> m_head;
+    /**
+     * @brief Spent node before the oldest unconsumed one; consumer only.
+     * Kept on its own cache line so producers do not disturb it.
+     */
+    alignas(64) node * m_tail;
+
+public:
+    /**
+     * @brief Constructs an empty queue.
+     */
+    mpscqueue() {
+        m_tail = new node;
+        m_head.store(m_tail,std::memory_order_relaxed);
+    }
+    /**
+     * @brief Releases every node, including values never popped.
+     */
+    ~mpscqueue() {
+        while (node * pNext = m_tail->next.load(std::memory_order_relaxed)) {
+            delete m_tail;
+            m_tail = pNext;
+        }
+        delete m_tail;
+    }
+    mpscqueue(const mpscqueue &) = delete;
+    mpscqueue & operator=(const mpscqueue &) = delete;
+
+    /**
+     * @brief Appends a value; safe to call from any number of threads.
+     *
+     * @param value The value to enqueue.
+     */
+    void push(T value) {
+        node * pNode = new node;
+        pNode->value = std::move(value);
+        node * pPrev = m_head.exchange(pNode,std::memory_order_acq_rel);
+        pPrev->next.store(pNode,std::memory_order_release);
+    }
+    /**
+     * @brief Removes the oldest value, if one is ready.
+     *
+     * @param value Receives the value.
+     * @return True if a value was removed.
+     */
+    bool pop(T & value) {
+        node * pNext = m_tail->next.load(std::memory_order_acquire);
+        if (pNext == nullptr) {
+            return false;
+        }
+        value = std::move(pNext->value);
+        delete m_tail;
+        m_tail = pNext;
+        return true;
+    }
+    /**
+     * @brief Hands up to iMax ready values, oldest first, to a callback.
+     *
+     * @param fn Called with each value as an rvalue.
+     * @param iMax Upper bound on the values taken in this call.
+     * @return The number of values taken.
+     */
+    template <class F>
+    size_t drain(F && fn,size_t iMax = SIZE_MAX) {
+        size_t iCount = 0;
+        while (iCount < iMax) {
+            node * pNext = m_tail->next.load(std::memory_order_acquire);
+            if (pNext == nullptr) {
+                break;
+            }
+            fn(std::move(pNext->value));
+            delete m_tail;
+            m_tail = pNext;
+            iCount++;
+        }
+        return iCount;
+    }
+    /**
+     * @brief Tells whether a value is ready; consumer only.
+     */
+    bool empty() const {
+        return m_tail->next.load(std::memory_order_acquire) == nullptr;
+    }
+};
+
+#endif //MPSCQUEUE_H
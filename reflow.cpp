@@ -0,0 +1,159 @@
+///////////////////////////////////////////////////////////////////////////////
+// /home/doug/CLionProjects/semigraphics/reflow.cpp  2026/10/17 17:05 dwg - //
+// Copyright (c) 2021-2026 Douglas Wade Goodall. All Rights Reserved.        //
+///////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <climits>
+
+#include "reflow.h"
+#include "utf8width.h"
+
+/**
+ * @brief Constructs an empty cache for 80 columns.
+ */
+reflow::reflow() {
+    m_iCols = 80;
+    m_iComputed = 0;
+}
+
+/**
+ * @brief Greedy word wrap with the range of widths the result holds for.
+ *
+ * Walks the code points once. When a glyph would overflow the line, the
+ * line ends after the last space on it, or before the glyph when there is
+ * none; an overflowing space ends the line and is dropped. That glyph
+ * would have fitted at its cumulative width, so the breaks stay valid
+ * below it (iHi). Each line's width is also the least the breaks need
+ * (iLo).
+ *
+ * @param ssRow The row text.
+ * @param iCols The width.
+ * @return The layout.
+ */
+reflow::layout reflow::wrap(std::string_view ssRow, int iCols) {
+    layout lay{0,INT_MAX,{}};
+    size_t n = ssRow.size();
+    size_t iStart = 0;
+    size_t iSpace = std::string_view::npos;     // just after the last space on the line
+    int iSpaceWidth = 0;
+    int iWidth = 0;
+    size_t i = 0;
+    while (i < n) {
+        char32_t cp = static_cast<unsigned char>(ssRow[i]);
+        size_t iLen = 1;
+        int iCp = 1;
+        if (cp < 0x20 || cp >= 0x7F) {
+            iLen = utf8_decode(ssRow,i,cp);
+            iCp = cp_width(cp);
+        }
+        if (iWidth + iCp > iCols && i > iStart) {
+            lay.iHi = std::min(lay.iHi,iWidth + iCp - 1);
+            size_t iEnd = i;
+            size_t iNext = i;
+            int iLine = iWidth;
+            if (cp == ' ') {
+                iNext = i + 1;
+            } else if (iSpace != std::string_view::npos) {
+                iEnd = iSpace;
+                iNext = iSpace;
+                iLine = iSpaceWidth;
+            }
+            lay.iLo = std::max(lay.iLo,iLine);
+            lay.breaks.push_back(static_cast<uint32_t>(iEnd));
+            lay.breaks.push_back(static_cast<uint32_t>(iNext));
+            iStart = iNext;
+            i = iNext;
+            iWidth = 0;
+            iSpace = std::string_view::npos;
+            continue;
+        }
+        iWidth += iCp;
+        i += iLen;
+        if (cp == ' ') {
+            iSpace = i;
+            iSpaceWidth = iWidth;
+        }
+    }
+    lay.iLo = std::max(lay.iLo,iWidth);
+    lay.iLo = std::min(lay.iLo,iCols);      // a lone glyph wider than the line
+    return lay;
+}
+
+/**
+ * @brief Sets the wrap width.
+ *
+ * @param iCols The width; values below 1 are raised to 1.
+ */
+void reflow::set_cols(int iCols) {
+    m_iCols = std::max(iCols,1);
+}
+
+/**
+ * @brief Finds a layout valid for m_iCols, wrapping the row if needed.
+ *
+ * @param iId The row number.
+ * @param ssRow The row text.
+ * @return The layout; valid until the next call.
+ */
+const reflow::layout & reflow::lookup(uint64_t iId, std::string_view ssRow) {
+    auto it = m_cache.find(iId);
+    if (it != m_cache.end() && it->second.iLo <= m_iCols && m_iCols <= it->second.iHi) {
+        return it->second;
+    }
+    if (it == m_cache.end() && m_cache.size() >= CACHE_MAX) {
+        m_cache.clear();
+    }
+    m_iComputed++;
+    layout & lay = m_cache[iId];
+    lay = wrap(ssRow,m_iCols);
+    return lay;
+}
+
+/**
+ * @brief Retrieves the number of lines a row takes.
+ *
+ * @param iId The row number.
+ * @param ssRow The row text.
+ * @return The line count.
+ */
+int reflow::lines(uint64_t iId, std::string_view ssRow) {
+    return static_cast<int>(lookup(iId,ssRow).breaks.size() / 2) + 1;
+}
+
+/**
+ * @brief Retrieves one line of a row.
+ *
+ * @param iId The row number.
+ * @param ssRow The row text.
+ * @param iLine The line index.
+ * @return The text of that line.
+ */
+std::string_view reflow::segment(uint64_t iId, std::string_view ssRow, int iLine) {
+    const layout & lay = lookup(iId,ssRow);
+    size_t iBreaks = lay.breaks.size() / 2;
+    size_t k = static_cast<size_t>(std::max(iLine,0));
+    size_t iBegin = k == 0 ? 0 : lay.breaks[2 * k - 1];
+    size_t iEnd = k < iBreaks ? lay.breaks[2 * k] : ssRow.size();
+    return ssRow.substr(iBegin,iEnd - iBegin);
+}
+
+/**
+ * @brief Drops a row's layout.
+ *
+ * @param iId The row number.
+ */
+void reflow::forget(uint64_t iId) {
+    m_cache.erase(iId);
+}
+
+/**
+ * @brief Drops every layout.
+ */
+void reflow::clear() {
+    m_cache.clear();
+}
+
+//////////////////////
+// eof - reflow.cpp //
+//////////////////////
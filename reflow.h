@@ -0,0 +1,140 @@
+/////////////////////////////////////////////////////////////////////////////
+// /home/doug/CLionProjects/semigraphics/reflow.h  2026/10/17 17:05 dwg - //
+// Copyright (c) 2021-2026 Douglas Wade Goodall. All Rights Reserved.      //
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef REFLOW_H
+#define REFLOW_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief How window rows wider than the text area are shown.
+ */
+enum WRAP_T {
+    WRAP_NONE,          // rows overflow the border (the original behaviour)
+    WRAP_TRUNCATE,      // rows are cut at the border
+    WRAP_WORD           // rows continue on further lines, broken after spaces
+};
+
+/**
+ * @class reflow
+ * @brief Word-wraps rows to a column width and caches the line breaks.
+ *
+ * Rows are identified by a caller-chosen number that stays the same while
+ * the row text does. Layouts are computed on first use only, so a window
+ * pays for the rows it shows, never for every row it holds.
+ *
+ * Each cached layout records the range of widths it is valid for: the
+ * greedy breaks stay the same from the widest line up to, but excluding,
+ * the first width at which some line would have taken one more glyph.
+ * After a resize only rows whose breaks really move are wrapped again;
+ * rows that fit either way cost a lookup.
+ */
+class reflow {
+    /**
+     * @brief The line breaks of one row.
+     */
+    struct layout {
+        int iLo;    // narrowest width the breaks are valid for
+        int iHi;    // widest width the breaks are valid for
+        /**
+         * Two entries per break: where the line before it ends and where
+         * the next one starts (after a space that was dropped, if any).
+         */
+        std::vector<uint32_t> breaks;
+    };
+    /**
+     * @brief Layouts by row number.
+     */
+    std::unordered_map<uint64_t,layout> m_cache;
+    /**
+     * @brief The width rows are wrapped to.
+     */
+    int m_iCols;
+    /**
+     * @brief Number of layouts computed so far.
+     */
+    uint64_t m_iComputed;
+
+    /**
+     * @brief Returns the layout of a row at m_iCols, computing it if the
+     * cached one is missing or not valid for that width.
+     */
+    const layout & lookup(uint64_t iId,std::string_view ssRow);
+
+public:
+    /**
+     * @brief Most layouts kept; beyond it the cache starts over.
+     */
+    static constexpr size_t CACHE_MAX = 16384;
+    /**
+     * @brief Constructs an engine wrapping to 80 columns.
+     */
+    reflow();
+    /**
+     * @brief Wraps a row greedily, breaking after spaces where possible.
+     *
+     * A space at which a line overflows is dropped; a word longer than the
+     * width is broken where it overflows.
+     *
+     * @param ssRow The row text.
+     * @param iCols The width; at least one glyph goes on every line.
+     * @return The breaks and the widths they are valid for.
+     */
+    static layout wrap(std::string_view ssRow,int iCols);
+    /**
+     * @brief Sets the width rows are wrapped to.
+     *
+     * Nothing is recomputed here; layouts are checked as rows are used.
+     *
+     * @param iCols The width in columns; at least 1.
+     */
+    void set_cols(int iCols);
+    /**
+     * @brief Retrieves the width rows are wrapped to.
+     */
+    int get_cols() const {
+        return m_iCols;
+    }
+    /**
+     * @brief Retrieves the number of lines a row wraps to.
+     *
+     * @param iId The row number.
+     * @param ssRow The row text.
+     * @return 1 or more.
+     */
+    int lines(uint64_t iId,std::string_view ssRow);
+    /**
+     * @brief Retrieves one line of a wrapped row.
+     *
+     * @param iId The row number.
+     * @param ssRow The row text.
+     * @param iLine The line, 0 <= iLine < lines().
+     * @return A view into ssRow.
+     */
+    std::string_view segment(uint64_t iId,std::string_view ssRow,int iLine);
+    /**
+     * @brief Drops the layout of a row whose text changed.
+     *
+     * @param iId The row number.
+     */
+    void forget(uint64_t iId);
+    /**
+     * @brief Drops every layout.
+     */
+    void clear();
+    /**
+     * @brief Retrieves the number of layouts computed, for measuring how
+     * much a resize cost.
+     */
+    uint64_t get_computed() const {
+        return m_iComputed;
+    }
+};
+
+#endif //REFLOW_H
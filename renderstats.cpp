@@ -0,0 +1,175 @@
+//////////////////////////////////////////////////////////////////////////////////
+// /home/doug/CLionProjects/semigraphics/renderstats.cpp 2026/10/17 15:00 dwg - //
+// Copyright (c) 2021-2026 Douglas Wade Goodall. All Rights Reserved.           //
+//////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cstdio>
+#include <mutex>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "renderstats.h"
+
+framestats renderstats::s_current;
+framestats renderstats::s_last;
+framestats renderstats::s_total;
+
+/**
+ * @brief The open trace file, or nullptr.
+ */
+static FILE * s_pTrace = nullptr;
+/**
+ * @brief Events not yet written to s_pTrace.
+ */
+static std::string s_ssTrace;
+/**
+ * @brief Time zero of the trace.
+ */
+static std::chrono::steady_clock::time_point s_tTraceStart;
+/**
+ * @brief True until the first event has been written, to place commas.
+ */
+static bool s_bFirstEvent = true;
+/**
+ * @brief Serialises trace_event() calls from different threads.
+ */
+static std::mutex s_mtxTrace;
+
+/**
+ * @brief Adds another set of counters to this one.
+ *
+ * @param other The counters to add.
+ * @return This object.
+ */
+framestats & framestats::operator+=(const framestats & other) {
+    iFrames += other.iFrames;
+    iEscapeBytes += other.iEscapeBytes;
+    iGlyphBytes += other.iGlyphBytes;
+    iWrites += other.iWrites;
+    iCellsDrawn += other.iCellsDrawn;
+    iCellsSkipped += other.iCellsSkipped;
+    iRowsIngested += other.iRowsIngested;
+    for (int i = 0; i < PHASE_COUNT; i++) {
+        ns[i] += other.ns[i];
+    }
+    return *this;
+}
+
+/**
+ * @brief Turns counting on or off and resets every counter.
+ *
+ * @param bEnable True to count.
+ */
+void renderstats::enable(bool bEnable) {
+    s_current = framestats{};
+    s_last = framestats{};
+    s_total = framestats{};
+    s_bEnabled = bEnable;
+}
+
+/**
+ * @brief Moves the current counters to last() and adds them to total().
+ */
+void renderstats::end_frame() {
+    if (!s_bEnabled) {
+        return;
+    }
+    s_current.iFrames = 1;
+    s_last = s_current;
+    s_total += s_current;
+    s_current = framestats{};
+}
+
+/**
+ * @brief Formats counters as one line of text.
+ *
+ * @param stats The counters; a sum over several frames is averaged.
+ * @return The formatted line.
+ */
+std::string renderstats::format(const framestats & stats) {
+    double dFrames = std::max<uint64_t>(stats.iFrames,1);
+    char szLine[256];
+    std::snprintf(szLine,sizeof(szLine),
+                  "frames %llu | per frame: esc %.0f B, glyph %.0f B, writes %.2f, "
+                  "cells %.0f drawn/%.0f skipped, rows %.0f, "
+                  "layout %.1f us, build %.1f us, flush %.1f us",
+                  static_cast<unsigned long long>(stats.iFrames),
+                  stats.iEscapeBytes / dFrames,stats.iGlyphBytes / dFrames,stats.iWrites / dFrames,
+                  stats.iCellsDrawn / dFrames,stats.iCellsSkipped / dFrames,stats.iRowsIngested / dFrames,
+                  stats.ns[PHASE_LAYOUT] / dFrames / 1000,stats.ns[PHASE_BUILD] / dFrames / 1000,
+                  stats.ns[PHASE_FLUSH] / dFrames / 1000);
+    return szLine;
+}
+
+/**
+ * @brief Creates the trace file and starts recording spans.
+ *
+ * @param ssPath Path of the JSON file.
+ * @return True if the file was created.
+ */
+bool renderstats::trace_open(const std::string & ssPath) {
+    trace_close();
+    s_pTrace = std::fopen(ssPath.c_str(),"w");
+    if (s_pTrace == nullptr) {
+        return false;
+    }
+    std::fputs("{\"traceEvents\":[\n",s_pTrace);
+    s_ssTrace.reserve(1 << 20);
+    s_tTraceStart = std::chrono::steady_clock::now();
+    s_bFirstEvent = true;
+    s_bTracing = true;
+    return true;
+}
+
+/**
+ * @brief Writes the buffered events, terminates the JSON and closes the file.
+ */
+void renderstats::trace_close() {
+    std::lock_guard<std::mutex> lock(s_mtxTrace);
+    if (s_pTrace == nullptr) {
+        return;
+    }
+    s_bTracing = false;
+    std::fwrite(s_ssTrace.data(),1,s_ssTrace.size(),s_pTrace);
+    s_ssTrace.clear();
+    std::fputs("\n],\"displayTimeUnit\":\"ns\"}\n",s_pTrace);
+    std::fclose(s_pTrace);
+    s_pTrace = nullptr;
+}
+
+/**
+ * @brief Appends one complete ("X") event to the trace.
+ *
+ * Events are buffered and written in blocks of about a megabyte.
+ *
+ * @param pszName The event name.
+ * @param tStart When the span began.
+ * @param tEnd When the span ended.
+ */
+void renderstats::trace_event(const char * pszName,
+                              std::chrono::steady_clock::time_point tStart,
+                              std::chrono::steady_clock::time_point tEnd) {
+    static const long iPid = static_cast<long>(getpid());
+    static thread_local const long iTid = static_cast<long>(syscall(SYS_gettid));
+    std::lock_guard<std::mutex> lock(s_mtxTrace);
+    if (s_pTrace == nullptr) {
+        return;
+    }
+    double dTs = std::chrono::duration<double,std::micro>(tStart - s_tTraceStart).count();
+    double dDur = std::chrono::duration<double,std::micro>(tEnd - tStart).count();
+    char szEvent[256];
+    int iLen = std::snprintf(szEvent,sizeof(szEvent),
+                             "%s{\"name\":\"%s\",\"cat\":\"render\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":%ld,\"tid\":%ld}",
+                             s_bFirstEvent ? "" : ",\n",pszName,dTs,dDur,iPid,iTid);
+    s_bFirstEvent = false;
+    s_ssTrace.append(szEvent,std::min<size_t>(iLen,sizeof(szEvent) - 1));
+    if (s_ssTrace.size() >= (1 << 20)) {
+        std::fwrite(s_ssTrace.data(),1,s_ssTrace.size(),s_pTrace);
+        s_ssTrace.clear();
+    }
+}
+
+///////////////////////////
+// eof - renderstats.cpp //
+///////////////////////////
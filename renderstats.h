@@ -0,0 +1,181 @@
+////////////////////////////////////////////////////////////////////////////////
+// /home/doug/CLionProjects/semigraphics/renderstats.h 2026/10/17 15:00 dwg - //
+// Copyright (c) 2021-2026 Douglas Wade Goodall. All Rights Reserved.         //
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef RENDERSTATS_H
+#define RENDERSTATS_H
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+/**
+ * @enum PHASE_T
+ * @brief Where render time is spent.
+ *
+ * - PHASE_NONE: Not timed; the span only appears in traces.
+ * - PHASE_LAYOUT: Drawing windows into a surface (compositing).
+ * - PHASE_BUILD: Encoding escape sequences and glyphs into a frame.
+ * - PHASE_FLUSH: Handing the frame to the sink.
+ */
+enum PHASE_T {
+    PHASE_NONE = -1,
+    PHASE_LAYOUT = 0,
+    PHASE_BUILD,
+    PHASE_FLUSH,
+    PHASE_COUNT
+};
+
+/**
+ * @struct framestats
+ * @brief Counters for one frame, or a sum of frames.
+ */
+struct framestats {
+    uint64_t iFrames = 0;           // frames summed here
+    uint64_t iEscapeBytes = 0;      // bytes of escape sequences and cursor controls
+    uint64_t iGlyphBytes = 0;       // bytes of glyphs and text
+    uint64_t iWrites = 0;           // write calls made by the sink
+    uint64_t iCellsDrawn = 0;       // surface cells sent to the terminal
+    uint64_t iCellsSkipped = 0;     // surface cells left alone as unchanged
+    uint64_t iRowsIngested = 0;     // rows added to windows
+    uint64_t ns[PHASE_COUNT] = {};  // nanoseconds per PHASE_T
+
+    /**
+     * @brief Adds another set of counters to this one.
+     */
+    framestats & operator+=(const framestats & other);
+};
+
+/**
+ * @class renderstats
+ * @brief Process-wide render counters and an optional Chrome trace.
+ *
+ * Everything is off by default. Each hook first tests a plain static flag,
+ * so a disabled hook costs one predictable branch and no clock reads.
+ * With counting enabled, the rendering code adds to the current frame's
+ * counters, and crtbind::crtflush() closes the frame (see last() and
+ * total()). With tracing enabled, every renderspan is written as a
+ * complete ("X") event in Chrome trace-event JSON. The file loads in
+ * chrome://tracing or Perfetto.
+ *
+ * Counters are updated only by the rendering thread; bands encoded on a
+ * pool report through it.
+ */
+class renderstats {
+    static inline bool s_bEnabled = false;
+    static inline bool s_bTracing = false;
+    static framestats s_current;
+    static framestats s_last;
+    static framestats s_total;
+
+public:
+    /**
+     * @brief Tells whether counting is on.
+     */
+    static bool enabled() { return s_bEnabled; }
+    /**
+     * @brief Tells whether a trace is being written.
+     */
+    static bool tracing() { return s_bTracing; }
+    /**
+     * @brief Turns counting on or off; the counters are reset.
+     */
+    static void enable(bool bEnable);
+    /**
+     * @brief Retrieves the counters of the frame being built.
+     */
+    static framestats & current() { return s_current; }
+    /**
+     * @brief Retrieves the counters of the last completed frame.
+     */
+    static const framestats & last() { return s_last; }
+    /**
+     * @brief Retrieves the sum over every completed frame since enable().
+     */
+    static const framestats & total() { return s_total; }
+    /**
+     * @brief Completes the current frame; called by crtbind::crtflush().
+     */
+    static void end_frame();
+    /**
+     * @brief Formats counters as one line of text.
+     *
+     * @param stats The counters; sums are shown per frame.
+     */
+    static std::string format(const framestats & stats);
+    /**
+     * @brief Starts writing a Chrome trace-event file.
+     *
+     * @param ssPath Path of the JSON file to create.
+     * @return True if the file was opened.
+     */
+    static bool trace_open(const std::string & ssPath);
+    /**
+     * @brief Finishes and closes the trace file.
+     */
+    static void trace_close();
+    /**
+     * @brief Records a complete event; used by renderspan.
+     *
+     * @param pszName The event name; must be a string literal or otherwise outlive the trace.
+     * @param tStart When the span began.
+     * @param tEnd When the span ended.
+     */
+    static void trace_event(const char * pszName,
+                            std::chrono::steady_clock::time_point tStart,
+                            std::chrono::steady_clock::time_point tEnd);
+    /**
+     * @brief Adds the elapsed time of an outermost span to a phase.
+     */
+    static void add_time(PHASE_T phase,std::chrono::steady_clock::duration d) {
+        s_current.ns[phase] += std::chrono::duration_cast<std::chrono::nanoseconds>(d).count();
+    }
+};
+
+/**
+ * @class renderspan
+ * @brief Times a scope into a phase and/or a trace event.
+ *
+ * Only the outermost timed span on a thread adds to its phase. That way
+ * compositor::compose() calling window::render() is counted once. When
+ * both counting and tracing are off, construction and destruction each
+ * test one flag.
+ */
+class renderspan {
+    static inline thread_local int t_iDepth = 0;
+    const char * m_pszName;
+    PHASE_T m_phase;
+    bool m_bActive;
+    std::chrono::steady_clock::time_point m_tStart;
+
+public:
+    renderspan(const char * pszName,PHASE_T phase = PHASE_NONE) : m_pszName(pszName), m_phase(phase) {
+        m_bActive = renderstats::enabled() || renderstats::tracing();
+        if (m_bActive) {
+            if (m_phase != PHASE_NONE && t_iDepth++ > 0) {
+                m_phase = PHASE_NONE;
+                t_iDepth--;
+            }
+            m_tStart = std::chrono::steady_clock::now();
+        }
+    }
+    ~renderspan() {
+        if (m_bActive) {
+            auto tEnd = std::chrono::steady_clock::now();
+            if (m_phase != PHASE_NONE) {
+                t_iDepth--;
+                if (renderstats::enabled()) {
+                    renderstats::add_time(m_phase,tEnd - m_tStart);
+                }
+            }
+            if (renderstats::tracing()) {
+                renderstats::trace_event(m_pszName,m_tStart,tEnd);
+            }
+        }
+    }
+    renderspan(const renderspan &) = delete;
+    renderspan & operator=(const renderspan &) = delete;
+};
+
+#endif //RENDERSTATS_H
@@ -0,0 +1,134 @@
+///////////////////////////////////////////////////////////////////////////////
+// /home/doug/CLionProjects/semigraphics/rowstore.cpp 2026/10/17 11:50 dwg - //
+// Copyright (c) 2021-2026 Douglas Wade Goodall. All Rights Reserved.        //
+///////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cstring>
+
+#include "rowstore.h"
+
+/**
+ * @brief Constructs an empty store.
+ */
+rowstore::rowstore() {
+    m_iHead = 0;
+    m_iDead = 0;
+}
+
+/**
+ * @brief Appends a row to the arena and records where it lies.
+ *
+ * @param ssRow The row text; cut to MAX_ROW bytes.
+ */
+void rowstore::append(std::string_view ssRow) {
+    ssRow = ssRow.substr(0,MAX_ROW);
+    m_spans.push_back(span(m_arena.size(),ssRow.size()));
+    m_arena.append(ssRow);
+}
+
+/**
+ * @brief Replaces the text of a row.
+ *
+ * @param i Row index.
+ * @param ssRow The new text; cut to MAX_ROW bytes.
+ */
+void rowstore::update(size_t i, std::string_view ssRow) {
+    ssRow = ssRow.substr(0,MAX_ROW);
+    uint64_t & v = m_spans[m_iHead + i];
+    uint64_t iOffset = v >> LEN_BITS;
+    size_t iLen = v & MAX_ROW;
+    if (ssRow.size() <= iLen) {
+        std::memcpy(m_arena.data() + iOffset,ssRow.data(),ssRow.size());
+        m_iDead += iLen - ssRow.size();
+        v = span(iOffset,ssRow.size());
+    } else {
+        m_iDead += iLen;
+        v = span(m_arena.size(),ssRow.size());
+        m_arena.append(ssRow);
+    }
+    maybe_compact();
+}
+
+/**
+ * @brief Removes one row.
+ *
+ * The index entries after it are shifted down, which is a memmove of
+ * eight bytes per following row; its text becomes dead space.
+ *
+ * @param i Row index.
+ */
+void rowstore::erase(size_t i) {
+    m_iDead += m_spans[m_iHead + i] & MAX_ROW;
+    m_spans.erase(m_spans.begin() + m_iHead + i);
+    maybe_compact();
+}
+
+/**
+ * @brief Removes the oldest rows.
+ *
+ * The rows are only marked dead here; see maybe_compact().
+ *
+ * @param iRows Number of rows to remove; clamped to size().
+ */
+void rowstore::drop_front(size_t iRows) {
+    iRows = std::min(iRows,size());
+    for (size_t i = 0; i < iRows; i++) {
+        m_iDead += m_spans[m_iHead + i] & MAX_ROW;
+    }
+    m_iHead += iRows;
+    maybe_compact();
+}
+
+/**
+ * @brief Compacts once the dead bytes or entries outnumber the live ones,
+ * which keeps the amortised cost per change constant.
+ */
+void rowstore::maybe_compact() {
+    if (m_iDead * 2 > m_arena.size() || m_iHead * 2 > m_spans.size()) {
+        compact();
+    }
+}
+
+/**
+ * @brief Copies the live rows, in order, into a new arena and rebases the
+ * index.
+ */
+void rowstore::compact() {
+    std::string arena;
+    arena.reserve(std::max(m_arena.capacity() / 2,bytes()));
+    for (size_t i = m_iHead; i < m_spans.size(); i++) {
+        uint64_t v = m_spans[i];
+        m_spans[i - m_iHead] = span(arena.size(),v & MAX_ROW);
+        arena.append(m_arena,v >> LEN_BITS,v & MAX_ROW);
+    }
+    m_spans.resize(m_spans.size() - m_iHead);
+    m_arena.swap(arena);
+    m_iHead = 0;
+    m_iDead = 0;
+}
+
+/**
+ * @brief Removes every row without releasing memory.
+ */
+void rowstore::clear() {
+    m_arena.clear();
+    m_spans.clear();
+    m_iHead = 0;
+    m_iDead = 0;
+}
+
+/**
+ * @brief Pre-allocates the arena and the index.
+ *
+ * @param iRows Expected number of rows.
+ * @param iBytes Expected number of text bytes.
+ */
+void rowstore::reserve(size_t iRows, size_t iBytes) {
+    m_spans.reserve(iRows);
+    m_arena.reserve(iBytes);
+}
+
+////////////////////////
+// eof - rowstore.cpp //
+////////////////////////
@@ -0,0 +1,140 @@
+//////////////////////////////////////////////////////////////////////////////
+// /home/doug/CLionProjects/semigraphics/rowstore.h  2026/10/17 11:50 dwg - //
+// Copyright (c) 2021-2026 Douglas Wade Goodall. All Rights Reserved.       //
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef ROWSTORE_H
+#define ROWSTORE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @class rowstore
+ * @brief Text rows packed back to back in one contiguous arena.
+ *
+ * A row costs its bytes plus one 8-byte index entry that packs its offset
+ * and length; there is no per-row heap allocation. Rows are read back as
+ * string views, which stay valid until the next call that modifies the
+ * store.
+ *
+ * Dropping rows from the front only advances m_iHead, and replaced or
+ * erased rows leave their old bytes behind as dead space. Both are
+ * compacted away once they outweigh the live rows, so a store used as a
+ * bounded log or an edited status pane costs amortised O(1) per change.
+ */
+class rowstore {
+    /**
+     * @brief The bytes of every row, live or dead.
+     */
+    std::string m_arena;
+    /**
+     * @brief Each row's offset in m_arena (upper 40 bits) and length (lower
+     * LEN_BITS bits).
+     */
+    std::vector<uint64_t> m_spans;
+    /**
+     * @brief Index in m_spans of the first live row.
+     */
+    size_t m_iHead;
+    /**
+     * @brief Bytes in m_arena that belong to no live row.
+     */
+    size_t m_iDead;
+
+    /**
+     * @brief Bits of an index entry holding the row length.
+     */
+    static constexpr int LEN_BITS = 24;
+
+    /**
+     * @brief Packs an offset and a length into an index entry.
+     */
+    static uint64_t span(uint64_t iOffset,size_t iLen) {
+        return iOffset << LEN_BITS | iLen;
+    }
+    /**
+     * @brief Copies the live rows into a fresh arena and drops dead entries.
+     */
+    void compact();
+    /**
+     * @brief Compacts when the dead bytes or entries outweigh the live ones.
+     */
+    void maybe_compact();
+
+public:
+    /**
+     * @brief Longest row kept, in bytes; longer rows are cut.
+     */
+    static constexpr size_t MAX_ROW = (size_t(1) << LEN_BITS) - 1;
+    /**
+     * @brief Constructs an empty store.
+     */
+    rowstore();
+    /**
+     * @brief Appends a row.
+     *
+     * @param ssRow The row text.
+     */
+    void append(std::string_view ssRow);
+    /**
+     * @brief Retrieves a row.
+     *
+     * @param i Row index, 0 <= i < size().
+     * @return A view of the row text.
+     */
+    std::string_view row(size_t i) const {
+        uint64_t v = m_spans[m_iHead+i];
+        return std::string_view(m_arena.data() + (v >> LEN_BITS),v & MAX_ROW);
+    }
+    /**
+     * @brief Retrieves the number of rows.
+     */
+    size_t size() const {
+        return m_spans.size() - m_iHead;
+    }
+    /**
+     * @brief Retrieves the number of text bytes held.
+     */
+    size_t bytes() const {
+        return m_arena.size() - m_iDead;
+    }
+    /**
+     * @brief Replaces the text of a row.
+     *
+     * Text that fits is written over the old bytes; longer text is appended
+     * to the arena and the old bytes become dead.
+     *
+     * @param i Row index, 0 <= i < size().
+     * @param ssRow The new text.
+     */
+    void update(size_t i,std::string_view ssRow);
+    /**
+     * @brief Removes one row; the rows after it move up by one.
+     *
+     * @param i Row index, 0 <= i < size().
+     */
+    void erase(size_t i);
+    /**
+     * @brief Removes the oldest rows.
+     *
+     * @param iRows Number of rows to remove; clamped to size().
+     */
+    void drop_front(size_t iRows);
+    /**
+     * @brief Removes every row, keeping the allocated capacity.
+     */
+    void clear();
+    /**
+     * @brief Pre-allocates room for rows and text bytes.
+     *
+     * @param iRows Expected number of rows.
+     * @param iBytes Expected number of text bytes.
+     */
+    void reserve(size_t iRows,size_t iBytes);
+};
+
+#endif //ROWSTORE_H
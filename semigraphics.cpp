@@ -3,8 +3,19 @@
 // Copyright (c) 2021-2025 Douglas Wade Goodall. All Rights Reserved.            //
 ///////////////////////////////////////////////////////////////////////////////////
 
-#include "std.h"
 #include "semigraphics.h"
+#include "crtbind.h"
+#include "surface.h"
+#include "utf8width.h"
+
+/**
+ * @brief Global pointer to the crtbind instance that owns the frame buffer.
+ *
+ * Unless set_crt() names another binding, every primitive appends its
+ * glyphs to this one; nothing is written to the terminal until the caller
+ * invokes gpCrt->crtflush().
+ */
+extern crtbind * gpCrt;
 
 
 /**
@@ -17,7 +28,10 @@
  * @return A default-initialized object of type semigraphics.
  */
 semigraphics::semigraphics() {
-
+    m_pTheme = &THEME_SQUARE;
+    m_custom = THEME_SQUARE;
+    m_pSurface = nullptr;
+    m_pCrt = nullptr;
 }
 
 /**
@@ -25,6 +39,7 @@ semigraphics::semigraphics() {
  *
  * This method sets various visual elements for rendering semigraphics,
  * including corners and lines used for creating box-like structures.
+ * The glyphs are encoded once into m_custom, which becomes the active theme.
  *
  * @param ssUL The character for the upper-left corner of the box.
  * @param ssUR The character for the upper-right corner of the box.
@@ -35,18 +50,30 @@ semigraphics::semigraphics() {
  * @param ssHL The character for the horizontal line.
  * @param ssVL The character for the vertical line.
  */
-void semigraphics::cosmetics(std::string ssUL,std::string ssUR,
-                             std::string ssLL,std::string ssLR,
-                             std::string ssVSR,std::string ssVSL,
-                             std::string ssHL,std::string ssVL) {
-    m_ssUL = ssUL;
-    m_ssUR = ssUR;
-    m_ssLL = ssLL;
-    m_ssLR = ssLR;
-    m_ssVSR = ssVSR;
-    m_ssVSL = ssVSL;
-    m_ssHL = ssHL;
-    m_ssVL = ssVL;
+void semigraphics::cosmetics(std::string_view ssUL,std::string_view ssUR,
+                             std::string_view ssLL,std::string_view ssLR,
+                             std::string_view ssVSR,std::string_view ssVSL,
+                             std::string_view ssHL,std::string_view ssVL) {
+    m_custom = make_theme(ssUL,ssUR,ssLL,ssLR,ssVSR,ssVSL,ssHL,ssVL);
+    m_pTheme = &m_custom;
+}
+
+/**
+ * @brief Selects the glyph table used by the primitives.
+ *
+ * @param pTheme The theme to draw with; it is referenced, not copied.
+ */
+void semigraphics::set_theme(const theme * pTheme) {
+    m_pTheme = pTheme;
+}
+
+/**
+ * @brief Retrieves the active glyph table.
+ *
+ * @return The theme in use.
+ */
+const theme * semigraphics::get_theme() {
+    return m_pTheme;
 }
 
 /**
@@ -62,31 +89,40 @@ void semigraphics::cosmetics(std::string ssUL,std::string ssUR,
  */
 void semigraphics::singlebox(int line, int col, int width, int height) {
 
-    // Top line of box
-    std::cout << m_ssUL;
-    for (int iColdex = col; iColdex<width-2; iColdex++) {
-        std::cout << m_ssHL;
+    if (m_pSurface) {
+        m_pSurface->put(line,col,bytes(GLYPH_UL));
+        m_pSurface->repeat(line,col+1,bytes(GLYPH_HL),width-3);
+        m_pSurface->put(line,col+width-2,bytes(GLYPH_UR));
+        for (int iLinedex = 1; iLinedex<=height; iLinedex++) {
+            m_pSurface->put(line+iLinedex,col,bytes(GLYPH_VL));
+            m_pSurface->repeat(line+iLinedex,col+1,"\u0020",width-3);
+            m_pSurface->put(line+iLinedex,col+width-2,bytes(GLYPH_VL));
+        }
+        m_pSurface->put(line+height+1,col,bytes(GLYPH_LL));
+        m_pSurface->repeat(line+height+1,col+1,bytes(GLYPH_HL),width-3);
+        m_pSurface->put(line+height+1,col+width-2,bytes(GLYPH_LR));
+        return;
     }
-    std::cout << m_ssUR;
-    std::cout << std::endl;
+
+    // Top line of box
+    crt()->crtputs(bytes(GLYPH_UL));
+    crt()->crtrepeat(bytes(GLYPH_HL),width-3);
+    crt()->crtputs(bytes(GLYPH_UR));
+    crt()->crtputs("\n");
 
     // Middle lines of box
     for (int iLinedex = 0; iLinedex<height; iLinedex++) {
-        std::cout << m_ssVL;
-        for (int iColdex = 0; iColdex<width-3; iColdex++) {
-            std::cout << "\u0020";
-        }
-        std::cout << m_ssVL;
-        std::cout << std::endl;
+        crt()->crtputs(bytes(GLYPH_VL));
+        crt()->crtpad(width-3);
+        crt()->crtputs(bytes(GLYPH_VL));
+        crt()->crtputs("\n");
     }
 
     // Bottom line of box
-    std::cout << m_ssLL;
-    for (int iColdex = col; iColdex<width-2; iColdex++) {
-        std::cout << m_ssHL;
-    }
-    std::cout << m_ssLR;
-    std::cout << std::endl;
+    crt()->crtputs(bytes(GLYPH_LL));
+    crt()->crtrepeat(bytes(GLYPH_HL),width-3);
+    crt()->crtputs(bytes(GLYPH_LR));
+    crt()->crtputs("\n");
 }
 
 /**
@@ -98,13 +134,20 @@ void semigraphics::singlebox(int line, int col, int width, int height) {
  * @param height The height of the box (currently not used in the function).
  */
 void semigraphics::topline(int line, int col, int width, int height) {
-    // Top line of box
-    std::cout << m_ssUL;
-    for (int iColdex = col; iColdex<width-2; iColdex++) {
-        std::cout << m_ssHL;
+    if (m_pSurface) {
+        if (!m_pSurface->visible(line,col,1,width-1)) {
+            return;
+        }
+        m_pSurface->put(line,col,bytes(GLYPH_UL));
+        m_pSurface->repeat(line,col+1,bytes(GLYPH_HL),width-3);
+        m_pSurface->put(line,col+width-2,bytes(GLYPH_UR));
+        return;
     }
-    std::cout << m_ssUR;
-    std::cout << std::endl;
+    // Top line of box
+    crt()->crtputs(bytes(GLYPH_UL));
+    crt()->crtrepeat(bytes(GLYPH_HL),width-3);
+    crt()->crtputs(bytes(GLYPH_UR));
+    crt()->crtputs("\n");
 }
 
 /**
@@ -119,18 +162,29 @@ void semigraphics::topline(int line, int col, int width, int height) {
  */
 void semigraphics::middleline(int line, int col,
                               int width, int height,
-                              std::string ssText) {
-    std::cout << m_ssVL;
-    std::cout << ssText;
-    int textlen = ssText.size();
+                              std::string_view ssText) {
+    if (m_pSurface) {
+        if (!m_pSurface->visible(line,col,1,width-1)) {
+            return;     // hidden under other windows: skip the text entirely
+        }
+        m_pSurface->put(line,col,bytes(GLYPH_VL));
+        int textlen = m_pSurface->puts(line,col+1,ssText);
+        if (textlen < width-3) {
+            m_pSurface->repeat(line,col+1+textlen," ",width-3-textlen);
+            textlen = width-3;
+        }
+        m_pSurface->put(line,col+1+textlen,bytes(GLYPH_VL));
+        return;
+    }
+    crt()->crtputs(bytes(GLYPH_VL));
+    crt()->crtputs(ssText);
+    int textlen = utf8_width(ssText);
     if (textlen < width-3) {
         int fillsize = width-3-textlen;
-        for (int i = 0; i<fillsize; i++) {
-            std::cout << " ";
-        }
+        crt()->crtpad(fillsize);
     }
-    std::cout << m_ssVL;
-    std::cout << std::endl;
+    crt()->crtputs(bytes(GLYPH_VL));
+    crt()->crtputs("\n");
 }
 
 /**
@@ -146,13 +200,20 @@ void semigraphics::middleline(int line, int col,
  * @param height The total height of the box containing the splitter.
  */
 void semigraphics::vert_splitter(int line, int col, int width, int height) {
-
-    std::cout << m_ssVSR;
-    for (int iColdex = col; iColdex<width-2; iColdex++) {
-        std::cout << m_ssHL;
+    if (m_pSurface) {
+        if (!m_pSurface->visible(line,col,1,width-1)) {
+            return;
+        }
+        m_pSurface->put(line,col,bytes(GLYPH_VSR));
+        m_pSurface->repeat(line,col+1,bytes(GLYPH_HL),width-3);
+        m_pSurface->put(line,col+width-2,bytes(GLYPH_VSL));
+        return;
     }
-    std::cout << m_ssVSL;
-    std::cout << std::endl;
+
+    crt()->crtputs(bytes(GLYPH_VSR));
+    crt()->crtrepeat(bytes(GLYPH_HL),width-3);
+    crt()->crtputs(bytes(GLYPH_VSL));
+    crt()->crtputs("\n");
 }
 
 
@@ -165,13 +226,103 @@ void semigraphics::vert_splitter(int line, int col, int width, int height) {
  * @param height The height of the area. This parameter does not directly affect this method's behavior.
  */
 void semigraphics::endline(int line, int col, int width, int height) {
+    if (m_pSurface) {
+        if (!m_pSurface->visible(line,col,1,width-1)) {
+            return;
+        }
+        m_pSurface->put(line,col,bytes(GLYPH_LL));
+        m_pSurface->repeat(line,col+1,bytes(GLYPH_HL),width-3);
+        m_pSurface->put(line,col+width-2,bytes(GLYPH_LR));
+        return;
+    }
+
+    crt()->crtputs(bytes(GLYPH_LL));
+    crt()->crtrepeat(bytes(GLYPH_HL),width-3);
+    crt()->crtputs(bytes(GLYPH_LR));
+    crt()->crtputs("\n");
+}
 
-    std::cout << m_ssLL;
-    for (int iColdex = col; iColdex<width-2; iColdex++) {
-        std::cout << m_ssHL;
+/**
+ * @brief Draws a line assembled by the caller.
+ *
+ * @param line The line to draw on; used in surface mode only.
+ * @param col The starting column; used in surface mode only.
+ * @param iCols The display width of the text.
+ * @param ssText The text, including any glyphs.
+ */
+void semigraphics::textline(int line, int col, int iCols, std::string_view ssText) {
+    if (m_pSurface) {
+        if (!m_pSurface->visible(line,col,1,iCols)) {
+            return;
+        }
+        m_pSurface->puts(line,col,ssText);
+        return;
+    }
+    crt()->crtputs(ssText);
+    crt()->crtputs("\n");
+}
+
+/**
+ * @brief Selects the surface the primitives draw into.
+ *
+ * @param pSurface The target surface, or nullptr to stream into gpCrt.
+ */
+void semigraphics::set_surface(surface * pSurface) {
+    m_pSurface = pSurface;
+}
+
+/**
+ * @brief Retrieves the active surface.
+ *
+ * @return The surface in use, or nullptr when streaming.
+ */
+surface * semigraphics::get_surface() {
+    return m_pSurface;
+}
+
+/**
+ * @brief Sends streamed output to a specific binding.
+ *
+ * @param pCrt The binding, or nullptr to follow gpCrt.
+ */
+void semigraphics::set_crt(crtbind * pCrt) {
+    m_pCrt = pCrt;
+}
+
+/**
+ * @brief Retrieves the binding streamed output goes to.
+ *
+ * @return The active binding.
+ */
+crtbind * semigraphics::get_crt() {
+    return crt();
+}
+
+/**
+ * @brief Resolves the binding streamed output goes to.
+ *
+ * gpCrt is looked up on each call so that it may be assigned after this
+ * object is constructed.
+ *
+ * @return m_pCrt, or gpCrt when none is set.
+ */
+crtbind * semigraphics::crt() const {
+    return m_pCrt ? m_pCrt : gpCrt;
+}
+
+/**
+ * @brief Sets the style for subsequently drawn glyphs.
+ *
+ * @param mode Text mode.
+ * @param fg Foreground color.
+ * @param bg Background color.
+ */
+void semigraphics::style(MODE_T mode, FG_COLORS_T fg, BG_COLORS_T bg) {
+    if (m_pSurface) {
+        m_pSurface->set_style(mode,fg,bg);
+        return;
     }
-    std::cout << m_ssLR;
-    std::cout << std::endl;
+    crt()->crtstyle(mode,fg,bg);
 }
 
 ////////////////////////////
@@ -0,0 +1,212 @@
+/////////////////////////////////////////////////////////////////////////////////
+// /home/doug/CLionProjects/semigraphics/semigraphics.cppm 2026/10/17 18:40 dwg - //
+// Copyright (c) 2021-2026 Douglas Wade Goodall. All Rights Reserved.             //
+/////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @file semigraphics.cppm
+ * @brief Module interface unit: `import semigraphics;` in place of the headers.
+ *
+ * The library headers are included in the global module fragment and their
+ * names re-exported with using-declarations, the way the standard library
+ * module does it. The declarations stay attached to the global module, so
+ * an importer links against the same static library as code that includes
+ * the headers, and may mix the two. Macros do not cross a module boundary:
+ * the glyph macros (SRUL, DHSDV, ...) still need semigraphics.h, while the
+ * THEME_* tables are exported.
+ *
+ * As with the headers, the program defines gpCrt and gpSemiGr.
+ */
+
+module;
+
+#include "crtsink.h"
+#include "crtinput.h"
+#include "crtbind.h"
+#include "semigraphics.h"
+#include "surface.h"
+#include "utf8width.h"
+#include "rowstore.h"
+#include "widthhist.h"
+#include "reflow.h"
+#include "mpscqueue.h"
+#include "window.h"
+#include "compositor.h"
+#include "threadpool.h"
+#include "tailsource.h"
+#include "table.h"
+#include "renderstats.h"
+#include "themed.h"
+
+export module semigraphics;
+
+// Output sinks and the terminal binding (crtsink.h, crtbind.h)
+export {
+    using ::crtsink;
+    using ::fdsink;
+    using ::filesink;
+    using ::memsink;
+    using ::nullsink;
+    using ::crtbind;
+    using ::crtrgb;
+    using ::MODE_T;
+    using ::MODE_RESET;
+    using ::MODE_BOLD;
+    using ::MODE_DIM;
+    using ::MODE_ITALIC;
+    using ::MODE_UNDERLINE;
+    using ::MODE_BLINK;
+    using ::MODE_REVERSE;
+    using ::MODE_HIDDEN;
+    using ::MODE_STRIKE;
+    using ::FG_COLORS_T;
+    using ::FG_BLACK;
+    using ::FG_RED;
+    using ::FG_GREEN;
+    using ::FG_YELLOW;
+    using ::FG_BLUE;
+    using ::FG_MAGENTA;
+    using ::FG_CYAN;
+    using ::FG_WHITE;
+    using ::BG_COLORS_T;
+    using ::BG_BLACK;
+    using ::BG_RED;
+    using ::BG_GREEN;
+    using ::BG_YELLOW;
+    using ::BG_BLUE;
+    using ::BG_MAGENTA;
+    using ::BG_CYAN;
+    using ::BG_WHITE;
+    using ::CAPS_T;
+    using ::CAP_REP;
+    using ::CAP_ECH;
+    using ::CAP_256;
+    using ::CAP_RGB;
+    using ::CAP_SYNC;
+}
+
+// Keyboard and mouse input (crtinput.h)
+export {
+    using ::crtinput;
+    using ::crtkey;
+    using ::KEY_T;
+    using ::KEY_NONE;
+    using ::KEY_CHAR;
+    using ::KEY_ENTER;
+    using ::KEY_TAB;
+    using ::KEY_BACKSPACE;
+    using ::KEY_ESCAPE;
+    using ::KEY_UP;
+    using ::KEY_DOWN;
+    using ::KEY_RIGHT;
+    using ::KEY_LEFT;
+    using ::KEY_HOME;
+    using ::KEY_END;
+    using ::KEY_INSERT;
+    using ::KEY_DELETE;
+    using ::KEY_PGUP;
+    using ::KEY_PGDN;
+    using ::KEY_F1;
+    using ::KEY_F12;
+    using ::KEY_MOUSE_PRESS;
+    using ::KEY_MOUSE_RELEASE;
+    using ::KEY_MOUSE_MOVE;
+    using ::KEY_WHEEL_UP;
+    using ::KEY_WHEEL_DOWN;
+    using ::KEY_PASTE_BEGIN;
+    using ::KEY_PASTE_END;
+    using ::MOD_T;
+    using ::MOD_SHIFT;
+    using ::MOD_ALT;
+    using ::MOD_CTRL;
+    using ::MOD_PASTE;
+    using ::INPUT_T;
+    using ::INPUT_MOUSE;
+    using ::INPUT_PASTE;
+}
+
+// Glyphs, themes and the drawing primitives (semigraphics.h, themed.h)
+export {
+    using ::GLYPH_T;
+    using ::GLYPH_UL;
+    using ::GLYPH_UR;
+    using ::GLYPH_LL;
+    using ::GLYPH_LR;
+    using ::GLYPH_VSR;
+    using ::GLYPH_VSL;
+    using ::GLYPH_HL;
+    using ::GLYPH_VL;
+    using ::GLYPH_COUNT;
+    using ::glyph;
+    using ::theme;
+    using ::make_glyph;
+    using ::make_theme;
+    using ::THEME_ROUNDED;
+    using ::THEME_SQUARE;
+    using ::THEME_DOUBLE;
+    using ::THEME_DHSV;
+    using ::THEME_SHDV;
+    using ::semigraphics;
+    using ::theme_rounded;
+    using ::theme_square;
+    using ::theme_double;
+    using ::theme_dhsv;
+    using ::theme_shdv;
+    using ::themed_semigraphics;
+}
+
+// Cell grid and display width (surface.h, utf8width.h)
+export {
+    using ::cell;
+    using ::surface;
+    using ::utf8_seqlen;
+    using ::utf8_decode;
+    using ::cp_width;
+    using ::utf8_width;
+    using ::utf8_fit;
+}
+
+// Windows and their parts (rowstore.h ... tailsource.h)
+export {
+    using ::rowstore;
+    using ::widthhist;
+    using ::WRAP_T;
+    using ::WRAP_NONE;
+    using ::WRAP_TRUNCATE;
+    using ::WRAP_WORD;
+    using ::reflow;
+    using ::mpscqueue;
+    using ::WinDesc;
+    using ::window;
+    using ::compositor;
+    using ::threadpool;
+    using ::tailsource;
+}
+
+// Tables (table.h)
+export {
+    using ::COLUMN_T;
+    using ::COLUMN_TEXT;
+    using ::COLUMN_INT;
+    using ::COLUMN_REAL;
+    using ::junctions;
+    using ::make_junctions;
+    using ::table;
+}
+
+// Render statistics (renderstats.h)
+export {
+    using ::PHASE_T;
+    using ::PHASE_NONE;
+    using ::PHASE_LAYOUT;
+    using ::PHASE_BUILD;
+    using ::PHASE_FLUSH;
+    using ::PHASE_COUNT;
+    using ::framestats;
+    using ::renderstats;
+    using ::renderspan;
+}
+
+////////////////////////////
+// eof - semigraphics.cppm //
+////////////////////////////
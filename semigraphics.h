@@ -6,6 +6,14 @@
 #ifndef SEMIGRAPHICS_H
 #define SEMIGRAPHICS_H
 
+#include <algorithm>
+#include <cstdint>
+#include <string_view>
+
+#include "crtbind.h"
+
+class surface;
+
 #define COPR "©"
 #define CHECK "✓"
 
@@ -75,74 +83,158 @@
 #define SHDVD "╥"   // single horizontal double vertical downward
 #define SHDVU "╨"   // single horizontal double vertical upward
 
+// Single Line Junctions
+#define SHSVD   "┬" // single horizontal single vertical downward
+#define SHSVU   "┴" // single horizontal single vertical upward
+#define SVERTEX "┼" // single horizontal single vertical cross
+
 // Angular Components
 #define FWDSLSH "╱" // lower left to upper right
 #define BCKSLSH "╲" // upper left to lower right
 #define SLNTEX  "╳"
 
 
+/**
+ * @enum GLYPH_T
+ * @brief Compact identifiers for the roles a glyph plays in a box.
+ *
+ * A theme stores one glyph per identifier, so the primitives look glyphs
+ * up by index instead of holding a string per role.
+ */
+enum GLYPH_T : uint8_t {
+    GLYPH_UL,       // upper-left corner
+    GLYPH_UR,       // upper-right corner
+    GLYPH_LL,       // lower-left corner
+    GLYPH_LR,       // lower-right corner
+    GLYPH_VSR,      // splitter junction on the left edge, pointing right
+    GLYPH_VSL,      // splitter junction on the right edge, pointing left
+    GLYPH_HL,       // horizontal line
+    GLYPH_VL,       // vertical line
+    GLYPH_COUNT
+};
+
+/**
+ * @struct glyph
+ * @brief One code point together with its pre-encoded UTF-8 bytes.
+ *
+ * Eight bytes, so that a whole theme fits in a single cache line and
+ * emitting a glyph is a fixed-size copy with no encoding or allocation.
+ */
+struct glyph {
+    uint32_t cp  : 24;  // Unicode code point
+    uint32_t len : 8;   // number of valid bytes in utf8
+    char     utf8[4];   // UTF-8 encoding of cp
+
+    /**
+     * @brief Views the encoded bytes.
+     *
+     * @return The UTF-8 bytes of the glyph.
+     */
+    constexpr std::string_view bytes() const {
+        return std::string_view(utf8,len);
+    }
+};
+
+/**
+ * @struct theme
+ * @brief A complete set of box glyphs indexed by GLYPH_T.
+ */
+struct alignas(64) theme {
+    glyph g[GLYPH_COUNT];
+};
+static_assert(sizeof(theme) == 64,"a theme should occupy one cache line");
+
+/**
+ * @brief Builds a glyph from the UTF-8 encoding of a single code point.
+ *
+ * Only the first code point of ssUtf8 is used. Usable at compile time with
+ * the box-drawing macros above.
+ *
+ * @param ssUtf8 The encoded glyph, e.g. SRUL.
+ * @return The glyph.
+ */
+constexpr glyph make_glyph(std::string_view ssUtf8) {
+    glyph gl{};
+    if (ssUtf8.empty()) {
+        return gl;
+    }
+    unsigned char ch = ssUtf8[0];
+    unsigned len = ch < 0x80 ? 1 : (ch & 0xE0) == 0xC0 ? 2 : (ch & 0xF0) == 0xE0 ? 3 :
+                   (ch & 0xF8) == 0xF0 ? 4 : 1;
+    len = std::min<unsigned>(len,ssUtf8.size());
+    uint32_t cp = len == 1 ? ch : ch & (0x7F >> len);
+    for (unsigned i = 0; i < len; i++) {
+        gl.utf8[i] = ssUtf8[i];
+        if (i > 0) {
+            cp = (cp << 6) | (static_cast<unsigned char>(ssUtf8[i]) & 0x3F);
+        }
+    }
+    gl.cp = cp;
+    gl.len = len;
+    return gl;
+}
+
+/**
+ * @brief Builds a theme from the eight glyph roles, in cosmetics() order.
+ */
+constexpr theme make_theme(std::string_view ssUL,std::string_view ssUR,
+                           std::string_view ssLL,std::string_view ssLR,
+                           std::string_view ssVSR,std::string_view ssVSL,
+                           std::string_view ssHL,std::string_view ssVL) {
+    return theme{{make_glyph(ssUL),make_glyph(ssUR),make_glyph(ssLL),make_glyph(ssLR),
+                  make_glyph(ssVSR),make_glyph(ssVSL),make_glyph(ssHL),make_glyph(ssVL)}};
+}
+
+// Predefined themes
+inline constexpr theme THEME_ROUNDED = make_theme(SRUL,SRUR,SRLL,SRLR,SVSR,SVSL,SH,SV);
+inline constexpr theme THEME_SQUARE  = make_theme(SSUL,SSUR,SSLL,SSLR,SVSR,SVSL,SH,SV);
+inline constexpr theme THEME_DOUBLE  = make_theme(DSUL,DSUR,DSLL,DSLR,DVDHR,DVDHL,DH,DV);
+inline constexpr theme THEME_DHSV    = make_theme(ULDHSV,URDHSV,LLDHSV,LRDHSV,SVDHR,SVDHL,DH,SV);
+inline constexpr theme THEME_SHDV    = make_theme(ULSHDV,URSHDV,LLSHDV,LRSHDV,DVSHR,DVSHL,SH,DV);
+
 /**
  * The semigraphics class provides methods for rendering semi-graphical boxes
  * and lines with customizable aesthetics in a text-based interface.
  */
 class semigraphics {
     /**
-     * Represents the character or symbol used for the upper-left corner of a box
-     * in semigraphics. This string is used to render graphical elements for the
-     * upper-left boundary of a box.
-     */
-    std::string m_ssUL;
-    /**
-     * Represents the top-right corner symbol of a box in the semigraphics.
-     * This member is used as part of the box rendering for graphical representations.
-     */
-    std::string m_ssUR;
-    /**
-     * Represents the lower-left corner symbol used for drawing boxes
-     * and outlines in the semigraphics class.
+     * @brief The glyph table the primitives draw with.
+     *
+     * Points either at one of the constexpr THEME_* tables or at m_custom.
+     * Switching themes is a pointer swap.
      */
-    std::string m_ssLL;
+    const theme * m_pTheme;
     /**
-     * Represents the lower-right corner symbol for the semigraphics object.
-     * This string is used to define the character that visually represents
-     * the lower-right corner in various graphic elements such as boxes
-     * and lines.
+     * @brief Storage for a glyph table assembled by cosmetics().
      */
-    std::string m_ssLR;
+    theme m_custom;
     /**
-     * A semigraphic character or string used for visual appearance in console UI designs.
+     * @brief Looks up the encoded bytes of a glyph in the active theme.
      *
-     * m_ssVSR is a character or string representing the vertical right splitter for dividing
-     * screen areas or elements in a tabular, boxed, or structured layout. It is typically
-     * used in constructing vertical splitters or dividers on the right side in console-based
-     * visual designs.
+     * @param id The glyph role.
+     * @return The pre-encoded UTF-8 bytes.
      */
-    std::string m_ssVSR;
+    std::string_view bytes(GLYPH_T id) const {
+        return m_pTheme->g[id].bytes();
+    }
     /**
-     * Represents the left vertical splitter character in semigraphics.
-     * This member variable is used to define and store the character or string
-     * that represents the left vertical boundary or splitter for rendering
-     * graphical elements in a semigraphics context.
+     * @brief Optional cell grid that the primitives draw into.
+     *
+     * When null (the default) the primitives stream glyphs into the gpCrt
+     * frame buffer at the current cursor position and ignore their line and
+     * col arguments. When set, they store cells into the surface at line/col
+     * and nothing is emitted until surface::present().
      */
-    std::string m_ssVSL;
+    surface * m_pSurface;
     /**
-     * @brief Represents the horizontal line segment used in the graphics.
-     *
-     * This member variable holds a string that defines the character(s) used
-     * to generate horizontal lines in components such as boxes, splitters, and lines.
-     * It is utilized in rendering graphical structures by methods like singlebox,
-     * topline, and vert_splitter.
+     * @brief The binding streamed output goes to; nullptr means gpCrt.
      */
-    std::string m_ssHL;
+    crtbind * m_pCrt;
+
     /**
-     * @brief Stores the vertical line character for box drawing.
-     *
-     * This member variable is used in the semigraphics class to define
-     * the character or string that represents vertical borders
-     * when drawing boxes or other graphical structures in a console-based
-     * context.
+     * @brief Resolves the binding streamed output goes to.
      */
-    std::string m_ssVL;
+    crtbind * crt() const;
 
     /**
      * @brief Constructor for the semigraphics class.
@@ -181,7 +273,7 @@ class semigraphics {
     /**
      * Draws a middle line of a box with optional text alignment within specified dimensions.
      *
-     * The function prints a line surrounded by vertical separators using the `m_ssVL` character.
+     * The function prints a line surrounded by vertical separators using the GLYPH_VL glyph.
      * If `ssText` is shorter than the designated width, the remaining space is filled with spaces
      * to align the text within the box. If the text exceeds the width, it is not truncated
      * by this function.
@@ -192,15 +284,15 @@ class semigraphics {
      * @param height The total height of the box (not utilized in this function).
      * @param ssText The text to be centered and displayed within the line.
      */
-    void middleline(int line, int col, int width, int height,std::string ssText);
+    void middleline(int line, int col, int width, int height,std::string_view ssText);
     /**
      * Draws a vertical splitter line within a defined rectangular region.
      *
      * The function uses preconfigured string assets as part of the `semigraphics` class
      * to construct a vertical splitter by printing characters on the console. It starts
-     * by outputting the `m_ssVSR` (vertical splitter right asset), followed by a series
-     * of `m_ssHL` (horizontal line asset) characters that span the width minus two columns.
-     * Finally, it outputs the `m_ssVSL` (vertical splitter left asset) and ends the line.
+     * by outputting the GLYPH_VSR (vertical splitter right) glyph, followed by a series
+     * of GLYPH_HL (horizontal line) glyphs that span the width minus two columns.
+     * Finally, it outputs the GLYPH_VSL (vertical splitter left) glyph and ends the line.
      *
      * Parameters:
      * - line: The starting line of the splitter.
@@ -224,6 +316,19 @@ class semigraphics {
      *               directly utilized in this function.
      */
     void endline(int line, int col, int width, int height);
+    /**
+     * @brief Draws one line of text that the caller assembled, glyphs and all.
+     *
+     * For widgets whose lines are not a plain box edge, such as a table
+     * rule with column junctions. The text is written as is and ends the
+     * line in streaming mode.
+     *
+     * @param line The line to draw on (surface mode).
+     * @param col The column the text starts at (surface mode).
+     * @param iCols The display width of ssText, used for the visibility test.
+     * @param ssText The UTF-8 text.
+     */
+    void textline(int line, int col, int iCols, std::string_view ssText);
     /**
      * @brief Configures the cosmetic characters used for rendering semigraphical elements.
      *
@@ -240,11 +345,63 @@ class semigraphics {
      * @param ssVSL Character used for the left vertical splitter.
      * @param ssHL Character used for horizontal lines.
      * @param ssVL Character used for vertical lines.
+     *
+     * The glyphs are encoded once into a private theme, which becomes the
+     * active theme; prefer set_theme() with a THEME_* table where possible.
+     */
+    void cosmetics(std::string_view UpperLeft,std::string_view UpperRight,
+                   std::string_view LowerLeft,std::string_view LowerRight,
+                   std::string_view VertSplitRight,std::string_view VertSplitLeft,
+                   std::string_view HorizontalLine,std::string_view VerticalLine);
+    /**
+     * @brief Switches the glyph table used by every primitive.
+     *
+     * The table is not copied and must outlive its use.
+     *
+     * @param pTheme The theme to draw with, e.g. &THEME_ROUNDED.
+     */
+    void set_theme(const theme * pTheme);
+    /**
+     * @brief Retrieves the active glyph table.
+     *
+     * @return The theme the primitives currently draw with.
+     */
+    const theme * get_theme();
+    /**
+     * @brief Redirects the primitives into a cell grid, or back to the stream.
+     *
+     * @param pSurface The surface to draw into, or nullptr to stream into gpCrt.
+     */
+    void set_surface(surface * pSurface);
+    /**
+     * @brief Retrieves the surface the primitives currently draw into.
+     *
+     * @return The active surface, or nullptr in streaming mode.
+     */
+    surface * get_surface();
+    /**
+     * @brief Sends streamed output to a specific binding, and so to its sink.
+     *
+     * @param pCrt The binding, or nullptr to follow gpCrt.
+     */
+    void set_crt(crtbind * pCrt);
+    /**
+     * @brief Retrieves the binding streamed output goes to.
+     *
+     * @return The binding set with set_crt(), or gpCrt.
+     */
+    crtbind * get_crt();
+    /**
+     * @brief Sets the style for the glyphs drawn next.
+     *
+     * Routes to surface::set_style() when a surface is active and to
+     * crtbind::crtstyle() otherwise.
+     *
+     * @param mode Text mode.
+     * @param fg Foreground color.
+     * @param bg Background color.
      */
-    void cosmetics(std::string UpperLeft,std::string UpperRight,
-                   std::string LowerLeft,std::string LowerRight,
-                   std::string VertSplitRight,std::string VertSplitLeft,
-                   std::string HorizontalLine,std::string VerticalLine);
+    void style(MODE_T mode,FG_COLORS_T fg,BG_COLORS_T bg);
 };
 
 
@@ -8,6 +8,11 @@
 // "import std;" line which is not yet supported in our devo tools.  //
 ///////////////////////////////////////////////////////////////////////
 
+// 2026/10/17 18:40 dwg - no longer included by the library; headers include what they use
+// 2026/10/17 17:05 dwg - added csignal for SIGWINCH
+// 2026/10/17 16:20 dwg - added bit for widthhist
+// 2026/10/17 12:10 dwg - added poll.h and sys/inotify.h for tailsource
+// 2026/10/17 09:40 dwg - added sys/ioctl.h for TIOCGWINSZ
 // 2024/12/29 05:00 dwg - updated modern includes from C++17 SLQR
 // 2024/12/22 07:00 dwg - added stdlib.h for system()
 
@@ -21,9 +26,12 @@
 #include <net/if.h>
 #include <netdb.h>
 #include <netinet/in.h>
+#include <poll.h>
 #include <pthread.h>
 //#include <stdio.h>        // deprecated by <cstdio>
 //#include <stdlib.h>       // deprecated by <cstdlib>
+#include <sys/inotify.h>
+#include <sys/ioctl.h>
 #include <sys/ipc.h>
 #include <sys/shm.h>
 #include <sys/socket.h>
@@ -52,6 +60,7 @@
 #include <any>
 #include <array>
 #include <atomic>
+#include <bit>          // added 2026-10-17 16:20 dwg - for widthhist
 #include <bitset>
 #include <cassert>
 #include <ccomplex>
@@ -67,6 +76,7 @@
 #include <codecvt>
 #include <complex>
 #include <condition_variable>
+#include <csignal>        // added 2026-10-17 17:05 dwg - for SIGWINCH
 #include <cstdarg>
 #include <cstdint>
 #include <cstdio>
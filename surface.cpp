@@ -0,0 +1,477 @@
+//////////////////////////////////////////////////////////////////////////////
+// /home/doug/CLionProjects/semigraphics/surface.cpp 2026/10/17 09:12 dwg - //
+// Copyright (c) 2021-2026 Douglas Wade Goodall. All Rights Reserved.       //
+//////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <numeric>
+
+#include "crtbind.h"
+#include "renderstats.h"
+#include "surface.h"
+#include "threadpool.h"
+#include "utf8width.h"
+
+/**
+ * @brief Global pointer to the crtbind instance that receives presented cells.
+ */
+extern crtbind * gpCrt;
+
+/**
+ * @brief Constructs a blank surface.
+ *
+ * @param iLines Number of lines in the grid.
+ * @param iCols Number of columns in the grid.
+ */
+surface::surface(int iLines, int iCols) {
+    m_blank = {{' '},1,MODE_RESET,FG_WHITE,BG_BLACK};
+    m_pen = m_blank;
+    m_iLines = 0;
+    m_iCols = 0;
+    m_bMasked = false;
+    m_iBandLines = 0;
+    m_pPool = nullptr;
+    resize(iLines,iCols);
+}
+
+/**
+ * @brief Destroys the surface and its band encoders.
+ */
+surface::~surface() = default;
+
+/**
+ * @brief Resizes the grid and schedules a full repaint.
+ *
+ * @param iLines New number of lines.
+ * @param iCols New number of columns.
+ */
+void surface::resize(int iLines, int iCols) {
+    m_iLines = std::max(iLines,0);
+    m_iCols = std::max(iCols,0);
+    m_back.assign(static_cast<size_t>(m_iLines) * m_iCols,m_blank);
+    m_front.assign(m_back.size(),m_blank);
+    m_covered.assign(m_back.size(),0);
+    m_bMasked = false;
+    m_bInvalid = true;
+}
+
+/**
+ * @brief Resets every cell of the back grid to blank.
+ */
+void surface::clear() {
+    std::fill(m_back.begin(),m_back.end(),m_blank);
+}
+
+/**
+ * @brief Marks the terminal content as unknown.
+ */
+void surface::invalidate() {
+    m_bInvalid = true;
+}
+
+/**
+ * @brief Protects a rectangle, clipped to the grid, from further drawing.
+ *
+ * @param line 1-based top line.
+ * @param col 1-based left column.
+ * @param iLines Height in lines.
+ * @param iCols Width in columns.
+ */
+void surface::cover(int line, int col, int iLines, int iCols) {
+    int iTop = std::max(line,1);
+    int iBottom = std::min(line + iLines - 1,m_iLines);
+    int iLeft = std::max(col,1);
+    int iRight = std::min(col + iCols - 1,m_iCols);
+    if (iTop > iBottom || iLeft > iRight) {
+        return;
+    }
+    for (int iLine = iTop; iLine <= iBottom; iLine++) {
+        size_t iRow = static_cast<size_t>(iLine-1) * m_iCols;
+        std::memset(&m_covered[iRow + iLeft - 1],1,iRight - iLeft + 1);
+    }
+    m_bMasked = true;
+}
+
+/**
+ * @brief Clears the coverage mask.
+ */
+void surface::uncover() {
+    if (m_bMasked) {
+        std::fill(m_covered.begin(),m_covered.end(),0);
+        m_bMasked = false;
+    }
+}
+
+/**
+ * @brief Tells whether a rectangle has any drawable cell.
+ *
+ * Each row of the rectangle is scanned with memchr for an uncovered cell,
+ * so a fully hidden window is rejected without touching its content.
+ *
+ * @param line 1-based top line.
+ * @param col 1-based left column.
+ * @param iLines Height in lines.
+ * @param iCols Width in columns.
+ * @return True if at least one cell is on the grid and uncovered.
+ */
+bool surface::visible(int line, int col, int iLines, int iCols) const {
+    int iTop = std::max(line,1);
+    int iBottom = std::min(line + iLines - 1,m_iLines);
+    int iLeft = std::max(col,1);
+    int iRight = std::min(col + iCols - 1,m_iCols);
+    if (iTop > iBottom || iLeft > iRight) {
+        return false;
+    }
+    if (!m_bMasked) {
+        return true;
+    }
+    for (int iLine = iTop; iLine <= iBottom; iLine++) {
+        size_t iRow = static_cast<size_t>(iLine-1) * m_iCols;
+        if (std::memchr(&m_covered[iRow + iLeft - 1],0,iRight - iLeft + 1)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Sets the pen style for subsequent drawing.
+ *
+ * @param mode Text mode.
+ * @param fg Foreground color.
+ * @param bg Background color.
+ */
+void surface::set_style(MODE_T mode, FG_COLORS_T fg, BG_COLORS_T bg) {
+    m_pen.mode = mode;
+    m_pen.fg = fg;
+    m_pen.bg = bg;
+}
+
+/**
+ * @brief Stores one glyph with the current pen style.
+ *
+ * Overwriting either half of a double-width glyph blanks the other half,
+ * so the grid never holds a dangling lead or continuation cell. Covered
+ * cells are left alone.
+ *
+ * @param line 1-based line.
+ * @param col 1-based column.
+ * @param ssGlyph UTF-8 bytes of the glyph; anything beyond four bytes is dropped.
+ */
+void surface::put(int line, int col, std::string_view ssGlyph) {
+    if (line < 1 || line > m_iLines || col < 1 || col > m_iCols) {
+        return;
+    }
+    size_t iRow = static_cast<size_t>(line-1) * m_iCols;
+    if (covered(iRow + col - 1)) {
+        return;
+    }
+    cell * pRow = &m_back[iRow];
+    cell & c = pRow[col-1];
+    if (c.len == 0 && col > 1 && !covered(iRow + col - 2)) {
+        pRow[col-2] = m_blank;          // we hit the right half of a wide glyph
+    }
+    if (col < m_iCols && pRow[col].len == 0 && !covered(iRow + col)) {
+        pRow[col] = m_blank;            // we replace the left half of a wide glyph
+    }
+    c = m_pen;
+    c.len = static_cast<uint8_t>(std::min<size_t>(ssGlyph.size(),sizeof(c.utf8)));
+    std::memcpy(c.utf8,ssGlyph.data(),c.len);
+}
+
+/**
+ * @brief Fills a horizontal run of cells with one glyph.
+ *
+ * @param line 1-based line.
+ * @param col 1-based first column.
+ * @param ssGlyph UTF-8 bytes of the glyph.
+ * @param iCount Number of cells.
+ */
+void surface::repeat(int line, int col, std::string_view ssGlyph, int iCount) {
+    if (line < 1 || line > m_iLines || iCount <= 0) {
+        return;
+    }
+    int iFirst = std::max(col,1);
+    int iLast = std::min(col + iCount - 1,m_iCols);
+    if (iFirst > iLast) {
+        return;
+    }
+    cell c = m_pen;
+    c.len = static_cast<uint8_t>(std::min<size_t>(ssGlyph.size(),sizeof(c.utf8)));
+    std::memcpy(c.utf8,ssGlyph.data(),c.len);
+    size_t iRow = static_cast<size_t>(line-1) * m_iCols;
+    cell * pRow = &m_back[iRow];
+    if (m_bMasked) {
+        // fill each uncovered span on its own
+        for (int iCol = iFirst; iCol <= iLast; iCol++) {
+            if (m_covered[iRow + iCol - 1]) {
+                continue;
+            }
+            int iEnd = iCol;
+            while (iEnd < iLast && !m_covered[iRow + iEnd]) {
+                iEnd++;
+            }
+            fill(pRow,iRow,iCol,iEnd,c);
+            iCol = iEnd;
+        }
+        return;
+    }
+    fill(pRow,iRow,iFirst,iLast,c);
+}
+
+/**
+ * @brief Fills columns iFirst..iLast of one row with a cell.
+ *
+ * Wide glyphs cut at either end lose their other half, unless it is covered.
+ *
+ * @param pRow The row in the back grid.
+ * @param iRow Grid index of the row's first cell.
+ * @param iFirst 1-based first column.
+ * @param iLast 1-based last column.
+ * @param c The cell to store.
+ */
+void surface::fill(cell * pRow, size_t iRow, int iFirst, int iLast, const cell & c) {
+    if (pRow[iFirst-1].len == 0 && iFirst > 1 && !covered(iRow + iFirst - 2)) {
+        pRow[iFirst-2] = m_blank;       // left half of a wide glyph we cut
+    }
+    if (iLast < m_iCols && pRow[iLast].len == 0 && !covered(iRow + iLast)) {
+        pRow[iLast] = m_blank;          // right half of a wide glyph we cut
+    }
+    std::fill(pRow + iFirst - 1,pRow + iLast,c);
+}
+
+/**
+ * @brief Writes UTF-8 text by display width.
+ *
+ * Narrow code points take one cell. Wide ones take a cell holding the glyph
+ * followed by a continuation cell with len 0. Zero-width code points are
+ * appended to the preceding cell when its four bytes have room, and
+ * dropped otherwise.
+ *
+ * @param line 1-based line.
+ * @param col 1-based first column.
+ * @param ssText The text.
+ * @return The number of columns consumed, including clipped ones.
+ */
+int surface::puts(int line, int col, std::string_view ssText) {
+    int iCols = 0;
+    size_t i = 0;
+    while (i < ssText.size()) {
+        unsigned char ch = ssText[i];
+        if (ch >= 0x20 && ch < 0x7F) {
+            put(line,col + iCols,ssText.substr(i,1));
+            i++;
+            iCols++;
+            continue;
+        }
+        char32_t cp;
+        size_t iLen = utf8_decode(ssText,i,cp);
+        int iWidth = cp_width(cp);
+        if (iWidth == 0) {
+            int iPrev = col + iCols - 1;
+            if (iCols > 0 && line >= 1 && line <= m_iLines && iPrev >= 1 && iPrev <= m_iCols) {
+                size_t iCell = static_cast<size_t>(line-1) * m_iCols + iPrev - 1;
+                cell & prev = m_back[iCell];
+                if (!covered(iCell) && prev.len != 0 && prev.len + iLen <= sizeof(prev.utf8)) {
+                    std::memcpy(prev.utf8 + prev.len,ssText.data() + i,iLen);
+                    prev.len += iLen;
+                }
+            }
+        } else if (iWidth == 2 && (col + iCols + 1 > m_iCols || masked(line,col + iCols + 1))) {
+            put(line,col + iCols," ");  // a wide glyph that does not fit
+        } else if (iWidth == 2 && masked(line,col + iCols)) {
+            put(line,col + iCols + 1," ");  // only the right half would show
+        } else {
+            put(line,col + iCols,ssText.substr(i,iLen));
+            int iCont = col + iCols + 1;
+            if (iWidth == 2 && line >= 1 && line <= m_iLines && iCont >= 2) {
+                cell * pRow = &m_back[static_cast<size_t>(line-1) * m_iCols];
+                if (iCont < m_iCols && pRow[iCont].len == 0 && !masked(line,iCont + 1)) {
+                    pRow[iCont] = m_blank;      // orphaned right half further on
+                }
+                pRow[iCont-1] = m_pen;
+                pRow[iCont-1].len = 0;
+            }
+        }
+        i += iLen;
+        iCols += iWidth;
+    }
+    return iCols;
+}
+
+/**
+ * @brief Emits only the cells that differ from the last presented frame.
+ *
+ * Unchanged rows are skipped with a single memcmp. Cursor moves go through
+ * crtbind::crtlc(), which plans the cheapest motion and emits nothing when
+ * the previous glyph left the cursor in place; crtbind likewise drops style
+ * changes that are already in effect. A short run of unchanged cells
+ * between two changed ones is reprinted instead of skipped when it has the
+ * current style and costs no more bytes than the cursor move would.
+ * Runs of identical changed cells go out through crtbind::crtrepeat(), which
+ * compresses them with REP when the terminal supports it.
+ *
+ * With bands set (see set_bands()) every band is encoded from a forgotten
+ * style and cursor, by its own crtbind, and the results are appended to
+ * gpCrt in order. The bytes are the same whether the bands run on a pool
+ * or one after another.
+ */
+void surface::present() {
+    renderspan span("surface::present",PHASE_BUILD);
+    if (m_bInvalid) {
+        gpCrt->crtstyle(static_cast<MODE_T>(m_blank.mode),
+                        static_cast<FG_COLORS_T>(m_blank.fg),
+                        static_cast<BG_COLORS_T>(m_blank.bg));
+        gpCrt->crtclr();
+        std::fill(m_front.begin(),m_front.end(),m_blank);
+        m_bInvalid = false;
+    }
+
+    if (m_iBandLines <= 0 || m_iBandLines >= m_iLines) {
+        count_cells(present_rows(gpCrt,1,m_iLines));
+        return;
+    }
+    size_t iBands = (m_iLines + m_iBandLines - 1) / m_iBandLines;
+    while (m_bands.size() < iBands) {
+        m_bands.push_back(std::make_unique<crtbind>());
+    }
+    m_bandCells.assign(iBands,0);
+    for (size_t b = 0; b < iBands; b++) {
+        m_bands[b]->crtmatch(*gpCrt);
+    }
+    std::function<void(size_t)> band = [this](size_t b) {
+        int iFirst = static_cast<int>(b) * m_iBandLines + 1;
+        m_bandCells[b] = present_rows(m_bands[b].get(),iFirst,std::min(iFirst + m_iBandLines - 1,m_iLines));
+    };
+    if (m_pPool) {
+        m_pPool->parallel_for(iBands,band);
+    } else {
+        for (size_t b = 0; b < iBands; b++) {
+            band(b);
+        }
+    }
+    for (size_t b = 0; b < iBands; b++) {
+        gpCrt->crtappend(*m_bands[b]);
+    }
+    count_cells(std::accumulate(m_bandCells.begin(),m_bandCells.end(),uint64_t{0}));
+}
+
+/**
+ * @brief Reports a presented frame's drawn and skipped cells to renderstats.
+ *
+ * @param iDrawn Cells sent to the terminal.
+ */
+void surface::count_cells(uint64_t iDrawn) {
+    if (renderstats::enabled()) {
+        uint64_t iCells = static_cast<uint64_t>(m_iLines) * m_iCols;
+        renderstats::current().iCellsDrawn += iDrawn;
+        renderstats::current().iCellsSkipped += iCells - std::min(iDrawn,iCells);
+    }
+}
+
+/**
+ * @brief Encodes the changed cells of lines iFirst..iLast into pCrt.
+ *
+ * Only those lines of m_front are updated, so disjoint ranges may be
+ * encoded concurrently.
+ *
+ * @param pCrt The encoder receiving the bytes.
+ * @param iFirst 1-based first line.
+ * @param iLast 1-based last line.
+ * @return The number of cells sent, reprinted gaps included.
+ */
+uint64_t surface::present_rows(crtbind * pCrt, int iFirst, int iLast) {
+    uint64_t iDrawn = 0;
+    for (int iLine = iFirst; iLine <= iLast; iLine++) {
+        size_t iRow = static_cast<size_t>(iLine-1) * m_iCols;
+        if (std::memcmp(&m_back[iRow],&m_front[iRow],m_iCols * sizeof(cell)) == 0) {
+            continue;
+        }
+        const cell * pLast = nullptr;   // last cell emitted on this row
+        int iNextCol = 0;               // column following pLast
+        for (int iCol = 1; iCol <= m_iCols; iCol++) {
+            const cell & c = m_back[iRow + iCol - 1];
+            if (c == m_front[iRow + iCol - 1]) {
+                continue;
+            }
+            if (c.len == 0) {
+                // right half of a wide glyph: drawn by its left half
+                m_front[iRow + iCol - 1] = c;
+                continue;
+            }
+            if (pLast && iCol > iNextCol) {
+                int iMoveCost = pCrt->crtlc_cost(iLine,iCol);
+                int iGapCost = 0;
+                for (int iGap = iNextCol; iGap < iCol && iGapCost <= iMoveCost; iGap++) {
+                    const cell & g = m_back[iRow + iGap - 1];
+                    if (g.mode != pLast->mode || g.fg != pLast->fg || g.bg != pLast->bg) {
+                        iGapCost = iMoveCost + 1;
+                        break;
+                    }
+                    iGapCost += g.len;
+                }
+                if (iGapCost <= iMoveCost) {
+                    iDrawn += iCol - iNextCol;
+                    for (int iGap = iNextCol; iGap < iCol; iGap++) {
+                        const cell & g = m_back[iRow + iGap - 1];
+                        pCrt->crtputs(std::string_view(g.utf8,g.len));
+                    }
+                }
+            }
+            pCrt->crtlc(iLine,iCol);
+            pCrt->crtstyle(static_cast<MODE_T>(c.mode),
+                           static_cast<FG_COLORS_T>(c.fg),
+                           static_cast<BG_COLORS_T>(c.bg));
+            int iRun = 1;
+            while (iCol + iRun <= m_iCols &&
+                   m_back[iRow + iCol + iRun - 1] == c &&
+                   !(m_front[iRow + iCol + iRun - 1] == c)) {
+                iRun++;
+            }
+            pCrt->crtrepeat(std::string_view(c.utf8,c.len),iRun);
+            iDrawn += iRun;
+            std::fill_n(&m_front[iRow + iCol - 1],iRun,c);
+            pLast = &c;
+            iCol += iRun - 1;
+            iNextCol = iCol + 1;
+        }
+    }
+    return iDrawn;
+}
+
+/**
+ * @brief Splits present() into bands of lines.
+ *
+ * @param iBandLines Lines per band; 0 presents the grid as one piece.
+ * @param pPool Pool that encodes the bands in parallel, or nullptr to
+ * encode them in turn.
+ */
+void surface::set_bands(int iBandLines, threadpool * pPool) {
+    m_iBandLines = std::max(iBandLines,0);
+    m_pPool = pPool;
+}
+
+/**
+ * @brief Retrieves the number of lines in the grid.
+ *
+ * @return The line count.
+ */
+int surface::get_lines() {
+    return m_iLines;
+}
+
+/**
+ * @brief Retrieves the number of columns in the grid.
+ *
+ * @return The column count.
+ */
+int surface::get_cols() {
+    return m_iCols;
+}
+
+///////////////////////
+// eof - surface.cpp //
+///////////////////////
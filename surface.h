@@ -0,0 +1,256 @@
+//////////////////////////////////////////////////////////////////////////////
+// /home/doug/CLionProjects/semigraphics/surface.h   2026/10/17 09:12 dwg - //
+// Copyright (c) 2021-2026 Douglas Wade Goodall. All Rights Reserved.       //
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef SURFACE_H
+#define SURFACE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+#include "crtbind.h"
+
+class threadpool;
+
+/**
+ * @struct cell
+ * @brief One character position of a surface: a glyph plus its style.
+ *
+ * The glyph is stored as its UTF-8 encoding (at most four bytes) so that
+ * presenting a cell is a plain byte copy. The style fields hold the
+ * MODE_T, FG_COLORS_T and BG_COLORS_T values used to draw it.
+ */
+struct cell {
+    char     utf8[4];   // UTF-8 encoding of the glyph
+    uint8_t  len;       // number of valid bytes in utf8
+    uint8_t  mode;      // MODE_T value
+    uint8_t  fg;        // FG_COLORS_T value
+    uint8_t  bg;        // BG_COLORS_T value
+
+    bool operator==(const cell& other) const = default;
+};
+
+/**
+ * @class surface
+ * @brief An in-memory grid of cells that is presented to the terminal by diff.
+ *
+ * Drawing calls only update the back grid. present() compares the back grid
+ * with the grid that was last presented and emits, through gpCrt, only the
+ * cells that changed. Coordinates are 1-based to match crtbind::crtlc();
+ * anything drawn outside the grid is clipped.
+ *
+ * Cells can also be covered with cover(); drawing calls leave covered
+ * cells untouched. The compositor draws windows top-down and covers each
+ * one after drawing it, so every cell is written once, by the highest
+ * window that holds it.
+ */
+class surface {
+    /**
+     * @brief Number of lines in the grid.
+     */
+    int m_iLines;
+    /**
+     * @brief Number of columns in the grid.
+     */
+    int m_iCols;
+    /**
+     * @brief The cell written by clear() and used for the initial screen.
+     */
+    cell m_blank;
+    /**
+     * @brief The style applied to cells drawn from now on.
+     */
+    cell m_pen;
+    /**
+     * @brief Cells being drawn for the next frame, row-major.
+     */
+    std::vector<cell> m_back;
+    /**
+     * @brief Cells as they were last presented to the terminal, row-major.
+     */
+    std::vector<cell> m_front;
+    /**
+     * @brief True when the terminal content is unknown and present() must
+     * clear the screen and repaint every non-blank cell.
+     */
+    bool m_bInvalid;
+    /**
+     * @brief One byte per cell, nonzero where drawing is masked out.
+     */
+    std::vector<uint8_t> m_covered;
+    /**
+     * @brief True while any cell is covered; lets unmasked drawing skip
+     * the per-cell test.
+     */
+    bool m_bMasked;
+    /**
+     * @brief Lines per band in present(); 0 presents in one piece.
+     */
+    int m_iBandLines;
+    /**
+     * @brief Pool that encodes bands in parallel, or nullptr.
+     */
+    threadpool * m_pPool;
+    /**
+     * @brief One encoder per band, kept between frames.
+     */
+    std::vector<std::unique_ptr<crtbind>> m_bands;
+    /**
+     * @brief Cells each band sent in the frame being presented.
+     */
+    std::vector<uint64_t> m_bandCells;
+
+    /**
+     * @brief Tells whether the cell at a 0-based grid index is covered.
+     */
+    bool covered(size_t iCell) const {
+        return m_bMasked && m_covered[iCell] != 0;
+    }
+    /**
+     * @brief Tells whether a 1-based position is on the grid and covered.
+     */
+    bool masked(int line,int col) const {
+        return m_bMasked && line >= 1 && line <= m_iLines && col >= 1 && col <= m_iCols &&
+               m_covered[static_cast<size_t>(line-1) * m_iCols + col - 1] != 0;
+    }
+    /**
+     * @brief Fills columns iFirst..iLast of one row, fixing up wide glyphs
+     * cut at either end.
+     */
+    void fill(cell * pRow,size_t iRow,int iFirst,int iLast,const cell & c);
+
+    /**
+     * @brief Encodes the changed cells of a range of lines.
+     *
+     * @return The number of cells sent.
+     */
+    uint64_t present_rows(crtbind * pCrt,int iFirst,int iLast);
+    /**
+     * @brief Reports drawn and skipped cells to renderstats.
+     */
+    void count_cells(uint64_t iDrawn);
+
+public:
+    /**
+     * @brief Constructs a surface of the given size filled with blanks.
+     *
+     * @param iLines Number of lines (rows) in the grid.
+     * @param iCols Number of columns in the grid.
+     */
+    surface(int iLines,int iCols);
+    /**
+     * @brief Destroys the surface and its band encoders.
+     */
+    ~surface();
+    /**
+     * @brief Changes the size of the grid.
+     *
+     * The back grid is cleared and the next present() repaints the screen.
+     *
+     * @param iLines New number of lines.
+     * @param iCols New number of columns.
+     */
+    void resize(int iLines,int iCols);
+    /**
+     * @brief Fills the back grid with blank cells.
+     */
+    void clear();
+    /**
+     * @brief Forces the next present() to repaint the whole screen.
+     *
+     * Use this after anything else has written to the terminal.
+     */
+    void invalidate();
+    /**
+     * @brief Protects a rectangle from further drawing.
+     *
+     * @param line 1-based top line.
+     * @param col 1-based left column.
+     * @param iLines Height in lines.
+     * @param iCols Width in columns.
+     */
+    void cover(int line,int col,int iLines,int iCols);
+    /**
+     * @brief Makes every cell drawable again.
+     */
+    void uncover();
+    /**
+     * @brief Tells whether any cell of a rectangle is on the grid and not
+     * covered.
+     *
+     * @param line 1-based top line.
+     * @param col 1-based left column.
+     * @param iLines Height in lines.
+     * @param iCols Width in columns.
+     * @return True if drawing the rectangle could change at least one cell.
+     */
+    bool visible(int line,int col,int iLines,int iCols) const;
+    /**
+     * @brief Sets the style used by subsequent drawing calls.
+     *
+     * @param mode Text mode for new cells.
+     * @param fg Foreground color for new cells.
+     * @param bg Background color for new cells.
+     */
+    void set_style(MODE_T mode,FG_COLORS_T fg,BG_COLORS_T bg);
+    /**
+     * @brief Writes one glyph at the given position.
+     *
+     * @param line 1-based line.
+     * @param col 1-based column.
+     * @param ssGlyph The UTF-8 encoding of a single glyph.
+     */
+    void put(int line,int col,std::string_view ssGlyph);
+    /**
+     * @brief Writes the same glyph into iCount consecutive columns.
+     *
+     * @param line 1-based line.
+     * @param col 1-based column of the first cell.
+     * @param ssGlyph The UTF-8 encoding of a single glyph.
+     * @param iCount Number of cells to fill.
+     */
+    void repeat(int line,int col,std::string_view ssGlyph,int iCount);
+    /**
+     * @brief Writes a UTF-8 string, one code point per cell.
+     *
+     * @param line 1-based line.
+     * @param col 1-based column of the first code point.
+     * @param ssText The text to write.
+     * @return The number of columns the text occupies.
+     */
+    int puts(int line,int col,std::string_view ssText);
+    /**
+     * @brief Emits the cells that changed since the last present().
+     *
+     * Escape sequences and glyphs are appended to the gpCrt frame buffer;
+     * the caller decides when to crtflush().
+     */
+    void present();
+    /**
+     * @brief Splits present() into horizontal bands encoded separately.
+     *
+     * Each band starts from an unknown style and cursor, so bands can be
+     * encoded in any order or at once and still concatenate to the same
+     * bytes. That costs one absolute move and one full style per band that
+     * changed.
+     *
+     * @param iBandLines Lines per band; 0 (the default) presents the grid
+     * in one piece.
+     * @param pPool Pool for parallel encoding, or nullptr to encode serially.
+     */
+    void set_bands(int iBandLines,threadpool * pPool = nullptr);
+    /**
+     * @brief Retrieves the number of lines in the grid.
+     */
+    int get_lines();
+    /**
+     * @brief Retrieves the number of columns in the grid.
+     */
+    int get_cols();
+};
+
+#endif //SURFACE_H
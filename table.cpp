@@ -0,0 +1,519 @@
+////////////////////////////////////////////////////////////////////////////
+// /home/doug/CLionProjects/semigraphics/table.cpp 2026/10/17 18:10 dwg - //
+// Copyright (c) 2021-2026 Douglas Wade Goodall. All Rights Reserved.     //
+////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+
+#include "table.h"
+#include "utf8width.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/**
+ * @brief The semigraphics instance the table draws with.
+ */
+extern semigraphics * gpSemiGr;
+
+/**
+ * @brief Returns the largest of a run of cell widths.
+ *
+ * SSE2 only has a signed 16-bit maximum, so the sign bit is flipped on the
+ * way in and out to order the widths as unsigned. Four accumulators keep
+ * 32 widths in flight per iteration.
+ *
+ * @param p The widths.
+ * @param n Number of widths.
+ * @return The maximum, or 0 when n is 0.
+ */
+static int max_width(const uint16_t * p,size_t n) {
+    size_t i = 0;
+    uint16_t uMax = 0;
+#if defined(__SSE2__)
+    const __m128i vSign = _mm_set1_epi16(static_cast<int16_t>(0x8000));
+    __m128i a = vSign;
+    __m128i b = vSign;
+    __m128i c = vSign;
+    __m128i d = vSign;
+    auto load = [&](size_t j) {
+        return _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p + j)),vSign);
+    };
+    for (; i + 32 <= n; i += 32) {
+        a = _mm_max_epi16(a,load(i));
+        b = _mm_max_epi16(b,load(i + 8));
+        c = _mm_max_epi16(c,load(i + 16));
+        d = _mm_max_epi16(d,load(i + 24));
+    }
+    for (; i + 8 <= n; i += 8) {
+        a = _mm_max_epi16(a,load(i));
+    }
+    a = _mm_max_epi16(_mm_max_epi16(a,b),_mm_max_epi16(c,d));
+    alignas(16) uint16_t lanes[8];
+    _mm_store_si128(reinterpret_cast<__m128i *>(lanes),_mm_xor_si128(a,vSign));
+    for (uint16_t u : lanes) {
+        uMax = std::max(uMax,u);
+    }
+#endif
+    for (; i < n; i++) {
+        uMax = std::max(uMax,p[i]);
+    }
+    return uMax;
+}
+
+/**
+ * @brief Constructs an empty table.
+ */
+table::table() {
+    m_iRows = 0;
+    m_x = 0;
+    m_y = 0;
+    m_iTop = 0;
+    m_iViewport = 0;
+    m_iVersion = 0;
+    m_iScans = 0;
+    m_szNum[0] = 0;
+}
+
+/**
+ * @brief Formats a numeric cell.
+ *
+ * Fixed notation is used for reals unless the value needs more digits than
+ * the buffer holds, in which case the shortest general form is used.
+ *
+ * @param c The column; COLUMN_INT or COLUMN_REAL.
+ * @param iRow Row index.
+ * @return A view of m_szNum.
+ */
+std::string_view table::format(const column & c,size_t iRow) {
+    char * pEnd = m_szNum + sizeof(m_szNum);
+    std::to_chars_result r;
+    if (c.type == COLUMN_INT) {
+        r = std::to_chars(m_szNum,pEnd,c.ints[iRow]);
+    } else {
+        r = std::to_chars(m_szNum,pEnd,c.reals[iRow],std::chars_format::fixed,c.iPrecision);
+        if (r.ec != std::errc()) {
+            r = std::to_chars(m_szNum,pEnd,c.reals[iRow]);
+        }
+    }
+    return std::string_view(m_szNum,r.ptr - m_szNum);
+}
+
+/**
+ * @brief Measures a cell.
+ *
+ * Formatted numbers are ASCII, so their width is their length.
+ *
+ * @param c The column.
+ * @param iRow Row index.
+ * @return The display width.
+ */
+int table::measure(column & c,size_t iRow) {
+    if (c.type == COLUMN_TEXT) {
+        return utf8_width(c.text.row(iRow));
+    }
+    return static_cast<int>(format(c,iRow).size());
+}
+
+/**
+ * @brief Records a cell's new width.
+ *
+ * A cell at least as wide as the column raises the maximum at once. A cell
+ * that was the widest and got narrower may have lowered it, which only a
+ * rescan can tell, so the column is marked and rescanned when next drawn.
+ *
+ * @param c The column.
+ * @param iRow Row index.
+ * @param iWidth The width; clamped to 65535.
+ */
+void table::resize_cell(column & c,size_t iRow,int iWidth) {
+    uint16_t uOld = c.widths[iRow];
+    uint16_t uNew = static_cast<uint16_t>(std::clamp(iWidth,0,0xFFFF));
+    c.widths[iRow] = uNew;
+    if (uNew >= c.iMax) {
+        c.iMax = uNew;
+    } else if (uOld == c.iMax) {
+        c.bDirty = true;
+    }
+    m_iVersion++;
+}
+
+/**
+ * @brief Returns a column's width, title included.
+ *
+ * @param c The column.
+ * @return The width without cell padding.
+ */
+int table::column_width(column & c) {
+    if (c.bDirty) {
+        c.iMax = max_width(c.widths.data(),c.widths.size());
+        c.bDirty = false;
+        m_iScans++;
+    }
+    return std::max(c.iMax,c.iTitleWidth);
+}
+
+/**
+ * @brief Appends a column, giving each existing row an empty cell.
+ *
+ * @param ssTitle The title.
+ * @param type What the column holds.
+ * @param iPrecision Digits after the point for COLUMN_REAL.
+ * @return The index of the column.
+ */
+size_t table::add_column(std::string_view ssTitle,COLUMN_T type,int iPrecision) {
+    column & c = m_cols.emplace_back();
+    c.ssTitle = ssTitle;
+    c.iTitleWidth = utf8_width(ssTitle);
+    c.type = type;
+    c.iPrecision = std::clamp(iPrecision,0,17);
+    c.iMax = 0;
+    c.bDirty = false;
+    c.widths.reserve(m_iRows);
+    for (size_t i = 0; i < m_iRows; i++) {
+        switch (type) {
+            case COLUMN_TEXT: c.text.append(""); break;
+            case COLUMN_INT:  c.ints.push_back(0); break;
+            case COLUMN_REAL: c.reals.push_back(0); break;
+        }
+        c.widths.push_back(0);
+        resize_cell(c,i,measure(c,i));
+    }
+    m_iVersion++;
+    return m_cols.size() - 1;
+}
+
+/**
+ * @brief Appends a row of empty cells.
+ *
+ * @return The index of the row.
+ */
+size_t table::add_row() {
+    for (column & c : m_cols) {
+        switch (c.type) {
+            case COLUMN_TEXT: c.text.append(""); break;
+            case COLUMN_INT:  c.ints.push_back(0); break;
+            case COLUMN_REAL: c.reals.push_back(0); break;
+        }
+        c.widths.push_back(0);
+        resize_cell(c,m_iRows,measure(c,m_iRows));
+    }
+    m_iVersion++;
+    return m_iRows++;
+}
+
+/**
+ * @brief Removes a row from every column.
+ *
+ * @param iRow Row index; out-of-range indices are ignored.
+ */
+void table::erase_row(size_t iRow) {
+    if (iRow >= m_iRows) {
+        return;
+    }
+    for (column & c : m_cols) {
+        switch (c.type) {
+            case COLUMN_TEXT: c.text.erase(iRow); break;
+            case COLUMN_INT:  c.ints.erase(c.ints.begin() + iRow); break;
+            case COLUMN_REAL: c.reals.erase(c.reals.begin() + iRow); break;
+        }
+        if (c.widths[iRow] == c.iMax && c.iMax > 0) {
+            c.bDirty = true;
+        }
+        c.widths.erase(c.widths.begin() + iRow);
+    }
+    m_iRows--;
+    scroll_to(m_iTop);
+    m_iVersion++;
+}
+
+/**
+ * @brief Removes every row; the columns and their titles stay.
+ */
+void table::clear() {
+    for (column & c : m_cols) {
+        c.text.clear();
+        c.ints.clear();
+        c.reals.clear();
+        c.widths.clear();
+        c.iMax = 0;
+        c.bDirty = false;
+    }
+    m_iRows = 0;
+    m_iTop = 0;
+    m_iVersion++;
+}
+
+/**
+ * @brief Stores text in a cell.
+ *
+ * @param iRow Row index; out-of-range cells are ignored.
+ * @param iCol Column index.
+ * @param ssText The text, parsed for numeric columns.
+ */
+void table::set(size_t iRow,size_t iCol,std::string_view ssText) {
+    if (iRow >= m_iRows || iCol >= m_cols.size()) {
+        return;
+    }
+    column & c = m_cols[iCol];
+    const char * pEnd = ssText.data() + ssText.size();
+    switch (c.type) {
+        case COLUMN_TEXT:
+            c.text.update(iRow,ssText);
+            break;
+        case COLUMN_INT:
+            c.ints[iRow] = 0;
+            std::from_chars(ssText.data(),pEnd,c.ints[iRow]);
+            break;
+        case COLUMN_REAL:
+            c.reals[iRow] = 0;
+            std::from_chars(ssText.data(),pEnd,c.reals[iRow]);
+            break;
+    }
+    resize_cell(c,iRow,measure(c,iRow));
+}
+
+/**
+ * @brief Stores an integer in a cell.
+ *
+ * @param iRow Row index; out-of-range cells are ignored.
+ * @param iCol Column index.
+ * @param iValue The value, formatted for text columns.
+ */
+void table::set_int(size_t iRow,size_t iCol,int64_t iValue) {
+    if (iRow >= m_iRows || iCol >= m_cols.size()) {
+        return;
+    }
+    column & c = m_cols[iCol];
+    switch (c.type) {
+        case COLUMN_TEXT: {
+            std::to_chars_result r = std::to_chars(m_szNum,m_szNum + sizeof(m_szNum),iValue);
+            c.text.update(iRow,std::string_view(m_szNum,r.ptr - m_szNum));
+            break;
+        }
+        case COLUMN_INT:  c.ints[iRow] = iValue; break;
+        case COLUMN_REAL: c.reals[iRow] = static_cast<double>(iValue); break;
+    }
+    resize_cell(c,iRow,measure(c,iRow));
+}
+
+/**
+ * @brief Stores a double in a cell.
+ *
+ * Integer columns truncate toward zero; values out of their range store 0.
+ *
+ * @param iRow Row index; out-of-range cells are ignored.
+ * @param iCol Column index.
+ * @param dValue The value, formatted at the column precision for text columns.
+ */
+void table::set_real(size_t iRow,size_t iCol,double dValue) {
+    if (iRow >= m_iRows || iCol >= m_cols.size()) {
+        return;
+    }
+    column & c = m_cols[iCol];
+    switch (c.type) {
+        case COLUMN_TEXT: {
+            char * pEnd = m_szNum + sizeof(m_szNum);
+            std::to_chars_result r = std::to_chars(m_szNum,pEnd,dValue,std::chars_format::fixed,c.iPrecision);
+            if (r.ec != std::errc()) {
+                r = std::to_chars(m_szNum,pEnd,dValue);
+            }
+            c.text.update(iRow,std::string_view(m_szNum,r.ptr - m_szNum));
+            break;
+        }
+        case COLUMN_INT:
+            c.ints[iRow] = std::fabs(dValue) < 9.2e18 ? static_cast<int64_t>(dValue) : 0;
+            break;
+        case COLUMN_REAL:
+            c.reals[iRow] = dValue;
+            break;
+    }
+    resize_cell(c,iRow,measure(c,iRow));
+}
+
+/**
+ * @brief Retrieves a cell as drawn.
+ *
+ * @param iRow Row index.
+ * @param iCol Column index.
+ * @return The text, or an empty view for out-of-range cells.
+ */
+std::string_view table::get(size_t iRow,size_t iCol) {
+    if (iRow >= m_iRows || iCol >= m_cols.size()) {
+        return {};
+    }
+    column & c = m_cols[iCol];
+    return c.type == COLUMN_TEXT ? c.text.row(iRow) : format(c,iRow);
+}
+
+/**
+ * @brief Retrieves the width of a column.
+ *
+ * @param iCol Column index.
+ * @return The width, or 0 for an out-of-range column.
+ */
+int table::get_column_width(size_t iCol) {
+    return iCol < m_cols.size() ? column_width(m_cols[iCol]) : 0;
+}
+
+/**
+ * @brief Moves the table.
+ *
+ * @param x Zero-relative column of the left edge.
+ * @param y Zero-relative line of the top edge.
+ */
+void table::set_position(int x,int y) {
+    m_x = x;
+    m_y = y;
+    m_iVersion++;
+}
+
+/**
+ * @brief Limits the number of rows shown.
+ *
+ * @param iRows Rows to show, or 0 for all.
+ */
+void table::set_viewport(int iRows) {
+    m_iViewport = std::max(iRows,0);
+    scroll_to(m_iTop);
+    m_iVersion++;
+}
+
+/**
+ * @brief Makes a row the first one shown.
+ *
+ * @param iRow Row index; clamped so that a viewport stays full.
+ */
+void table::scroll_to(size_t iRow) {
+    size_t iLast = m_iViewport > 0 && m_iRows > size_t(m_iViewport) ? m_iRows - m_iViewport : 0;
+    m_iTop = std::min(iRow,iLast);
+    m_iVersion++;
+}
+
+/**
+ * @brief Retrieves the number of lines drawn.
+ *
+ * @return Three rules and the title line, plus the rows shown; 0 without
+ * columns.
+ */
+int table::get_frame_lines() {
+    if (m_cols.empty()) {
+        return 0;
+    }
+    size_t iShown = m_iRows - m_iTop;
+    if (m_iViewport > 0) {
+        iShown = std::min(iShown,size_t(m_iViewport));
+    }
+    return 4 + static_cast<int>(iShown);
+}
+
+/**
+ * @brief Retrieves the number of columns drawn.
+ *
+ * @return Each column with a space either side and a separator, plus the
+ * left border; 0 without columns.
+ */
+int table::get_frame_cols() {
+    if (m_cols.empty()) {
+        return 0;
+    }
+    int iCols = 1;
+    for (column & c : m_cols) {
+        iCols += column_width(c) + 3;
+    }
+    return iCols;
+}
+
+/**
+ * @brief Appends a horizontal rule.
+ *
+ * @param left The glyph on the left border.
+ * @param junction The glyph between columns.
+ * @param right The glyph on the right border.
+ */
+void table::rule(GLYPH_T left,const glyph & junction,GLYPH_T right) {
+    const theme & th = *gpSemiGr->get_theme();
+    std::string_view ssHL = th.g[GLYPH_HL].bytes();
+    m_ssLine.append(th.g[left].bytes());
+    for (size_t i = 0; i < m_cols.size(); i++) {
+        for (int j = column_width(m_cols[i]) + 2; j > 0; j--) {
+            m_ssLine.append(ssHL);
+        }
+        m_ssLine.append(i + 1 < m_cols.size() ? junction.bytes() : th.g[right].bytes());
+    }
+}
+
+/**
+ * @brief Appends a line of cells, padded to the column widths.
+ *
+ * Text is left aligned and numbers right aligned, titles included.
+ *
+ * @param iRow Row index, or SIZE_MAX for the titles.
+ */
+void table::cells(size_t iRow) {
+    std::string_view ssVL = gpSemiGr->get_theme()->g[GLYPH_VL].bytes();
+    m_ssLine.append(ssVL);
+    for (column & c : m_cols) {
+        bool bTitle = iRow == SIZE_MAX;
+        std::string_view ssCell = bTitle ? std::string_view(c.ssTitle) :
+                                  c.type == COLUMN_TEXT ? c.text.row(iRow) : format(c,iRow);
+        int iPad = std::max(column_width(c) - (bTitle ? c.iTitleWidth : c.widths[iRow]),0);
+        m_ssLine.push_back(' ');
+        if (c.type != COLUMN_TEXT) {
+            m_ssLine.append(iPad,' ');
+        }
+        m_ssLine.append(ssCell);
+        if (c.type == COLUMN_TEXT) {
+            m_ssLine.append(iPad,' ');
+        }
+        m_ssLine.push_back(' ');
+        m_ssLine.append(ssVL);
+    }
+}
+
+/**
+ * @brief Draws the table.
+ *
+ * Each line is assembled in m_ssLine, whose capacity is kept from frame to
+ * frame, and handed to semigraphics::textline(), so the table draws into a
+ * surface or a stream like the other widgets. Column widths are settled
+ * before the first line, which is where any pending rescans happen.
+ */
+void table::render() {
+    int iCols = get_frame_cols();
+    if (iCols == 0) {
+        return;
+    }
+    int iLines = get_frame_lines();
+    junctions jn = make_junctions(*gpSemiGr->get_theme());
+    int iLine = m_y + 1;
+    int iCol = m_x + 1;
+    gpSemiGr->style(MODE_BOLD,FG_GREEN,BG_BLACK);
+    m_ssLine.clear();
+    rule(GLYPH_UL,jn.down,GLYPH_UR);
+    gpSemiGr->textline(iLine++,iCol,iCols,m_ssLine);
+    m_ssLine.clear();
+    cells(SIZE_MAX);
+    gpSemiGr->textline(iLine++,iCol,iCols,m_ssLine);
+    m_ssLine.clear();
+    rule(GLYPH_VSR,jn.cross,GLYPH_VSL);
+    gpSemiGr->textline(iLine++,iCol,iCols,m_ssLine);
+    gpSemiGr->style(MODE_BOLD,FG_CYAN,BG_BLACK);
+    for (size_t i = m_iTop, iEnd = m_iTop + iLines - 4; i < iEnd; i++) {
+        m_ssLine.clear();
+        cells(i);
+        gpSemiGr->textline(iLine++,iCol,iCols,m_ssLine);
+    }
+    gpSemiGr->style(MODE_BOLD,FG_GREEN,BG_BLACK);
+    m_ssLine.clear();
+    rule(GLYPH_LL,jn.up,GLYPH_LR);
+    gpSemiGr->textline(iLine,iCol,iCols,m_ssLine);
+    gpSemiGr->style(MODE_BOLD,FG_CYAN,BG_BLACK);
+}
+
+/////////////////////
+// eof - table.cpp //
+/////////////////////
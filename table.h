@@ -0,0 +1,286 @@
+////////////////////////////////////////////////////////////////////////////
+// /home/doug/CLionProjects/semigraphics/table.h  2026/10/17 18:10 dwg - //
+// Copyright (c) 2021-2026 Douglas Wade Goodall. All Rights Reserved.     //
+////////////////////////////////////////////////////////////////////////////
+
+#ifndef TABLE_H
+#define TABLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "rowstore.h"
+#include "semigraphics.h"
+
+/**
+ * @brief What a table column holds, and so how its cells are aligned.
+ */
+enum COLUMN_T {
+    COLUMN_TEXT,        // UTF-8 text, left aligned
+    COLUMN_INT,         // 64-bit integers, right aligned
+    COLUMN_REAL         // doubles in fixed notation, right aligned
+};
+
+/**
+ * @struct junctions
+ * @brief The glyphs where a column separator meets a horizontal rule.
+ */
+struct junctions {
+    glyph down;     // top rule, e.g. DHSDV
+    glyph up;       // bottom rule, e.g. DHSUV
+    glyph cross;    // rule under the titles, e.g. DHSVUP
+};
+
+/**
+ * @brief Picks the junctions that match a theme's line weights.
+ *
+ * A theme carries only the eight box glyphs, so the junctions are chosen
+ * from whether its horizontal and vertical lines are single or double.
+ *
+ * @param th The theme the table is drawn with.
+ * @return The junction glyphs.
+ */
+constexpr junctions make_junctions(const theme & th) {
+    bool bDH = th.g[GLYPH_HL].cp == make_glyph(DH).cp;
+    bool bDV = th.g[GLYPH_VL].cp == make_glyph(DV).cp;
+    if (bDH && bDV) {
+        return {make_glyph(DHDVD),make_glyph(DHDVU),make_glyph(DVERTEX)};
+    }
+    if (bDH) {
+        return {make_glyph(DHSDV),make_glyph(DHSUV),make_glyph(DHSVUP)};
+    }
+    if (bDV) {
+        return {make_glyph(SHDVD),make_glyph(SHDVU),make_glyph(DVSHRL)};
+    }
+    return {make_glyph(SHSVD),make_glyph(SHSVU),make_glyph(SVERTEX)};
+}
+
+/**
+ * @class table
+ * @brief A boxed grid of titled columns, stored and sized column by column.
+ *
+ * Each column keeps its cells in its own store (a rowstore for text, a
+ * plain vector for numbers) next to a vector of cell display widths. A
+ * column's width is the maximum of that vector, kept up to date as cells
+ * change: a wider cell raises it at once, and only when the widest cell
+ * shrinks or goes is the column marked for a rescan. Rescans happen when
+ * the table is drawn, at most once per column per frame, eight or more
+ * widths per instruction.
+ *
+ * Numbers are kept as numbers and formatted with std::to_chars into a
+ * buffer owned by the table, so changing or drawing a numeric cell does
+ * not allocate. Drawing costs the rows in the viewport, not the rows held.
+ */
+class table {
+    /**
+     * @brief One column's title, cells and cell widths.
+     */
+    struct column {
+        std::string ssTitle;
+        int iTitleWidth;
+        COLUMN_T type;
+        int iPrecision;                 // digits after the point, COLUMN_REAL
+        rowstore text;                  // cells of a COLUMN_TEXT column
+        std::vector<int64_t> ints;      // cells of a COLUMN_INT column
+        std::vector<double> reals;      // cells of a COLUMN_REAL column
+        std::vector<uint16_t> widths;   // display width of each cell
+        int iMax;                       // widest cell; stale while bDirty
+        bool bDirty;
+    };
+    /**
+     * @brief The columns, left to right.
+     */
+    std::vector<column> m_cols;
+    /**
+     * @brief Number of rows; every column holds this many cells.
+     */
+    size_t m_iRows;
+    /**
+     * @brief Zero-relative column and line of the top-left corner.
+     */
+    int m_x;
+    int m_y;
+    /**
+     * @brief First row shown.
+     */
+    size_t m_iTop;
+    /**
+     * @brief Number of rows shown, or 0 to show them all.
+     */
+    int m_iViewport;
+    /**
+     * @brief Bumped by every change to what render() would draw.
+     */
+    uint64_t m_iVersion;
+    /**
+     * @brief Number of column rescans so far.
+     */
+    uint64_t m_iScans;
+    /**
+     * @brief Scratch for formatting numeric cells.
+     */
+    char m_szNum[64];
+    /**
+     * @brief The line being assembled by render(); its capacity is reused.
+     */
+    std::string m_ssLine;
+
+    /**
+     * @brief Formats a numeric cell into m_szNum.
+     */
+    std::string_view format(const column & c,size_t iRow);
+    /**
+     * @brief Records the new width of a cell, keeping the column maximum
+     * current or marking it for a rescan.
+     */
+    void resize_cell(column & c,size_t iRow,int iWidth);
+    /**
+     * @brief Measures a cell after its value was stored.
+     */
+    int measure(column & c,size_t iRow);
+    /**
+     * @brief Returns a column's width, rescanning its cells if marked dirty.
+     */
+    int column_width(column & c);
+    /**
+     * @brief Appends a horizontal rule to m_ssLine.
+     */
+    void rule(GLYPH_T left,const glyph & junction,GLYPH_T right);
+    /**
+     * @brief Appends a line of cells (or of titles when iRow is SIZE_MAX) to
+     * m_ssLine.
+     */
+    void cells(size_t iRow);
+
+public:
+    /**
+     * @brief Constructs an empty table with no columns.
+     */
+    table();
+    /**
+     * @brief Appends a column; existing rows get an empty cell (0 for numbers).
+     *
+     * @param ssTitle The column title.
+     * @param type What the column holds.
+     * @param iPrecision Digits after the point for COLUMN_REAL.
+     * @return The index of the new column.
+     */
+    size_t add_column(std::string_view ssTitle,COLUMN_T type = COLUMN_TEXT,int iPrecision = 2);
+    /**
+     * @brief Appends a row of empty cells (0 for numbers).
+     *
+     * @return The index of the new row.
+     */
+    size_t add_row();
+    /**
+     * @brief Removes a row; the rows after it move up by one.
+     *
+     * @param iRow Row index, 0 <= iRow < get_row_count().
+     */
+    void erase_row(size_t iRow);
+    /**
+     * @brief Removes every row, keeping the columns.
+     */
+    void clear();
+    /**
+     * @brief Stores text in a cell.
+     *
+     * A numeric column parses the text with std::from_chars; text that does
+     * not start with a number stores 0.
+     *
+     * @param iRow Row index.
+     * @param iCol Column index.
+     * @param ssText The UTF-8 text.
+     */
+    void set(size_t iRow,size_t iCol,std::string_view ssText);
+    /**
+     * @brief Stores an integer in a cell, converting it to the column type.
+     */
+    void set_int(size_t iRow,size_t iCol,int64_t iValue);
+    /**
+     * @brief Stores a double in a cell, converting it to the column type.
+     */
+    void set_real(size_t iRow,size_t iCol,double dValue);
+    /**
+     * @brief Retrieves a cell as it is drawn.
+     *
+     * @param iRow Row index.
+     * @param iCol Column index.
+     * @return The text; for numeric cells valid until the next call.
+     */
+    std::string_view get(size_t iRow,size_t iCol);
+    /**
+     * @brief Retrieves the width a column is drawn at, title included.
+     *
+     * @param iCol Column index.
+     * @return The width in columns, without the padding around cells.
+     */
+    int get_column_width(size_t iCol);
+    /**
+     * @brief Retrieves the number of rows.
+     */
+    size_t get_row_count() const {
+        return m_iRows;
+    }
+    /**
+     * @brief Retrieves the number of columns.
+     */
+    size_t get_column_count() const {
+        return m_cols.size();
+    }
+    /**
+     * @brief Moves the table.
+     *
+     * @param x Zero-relative column of the left edge.
+     * @param y Zero-relative line of the top edge.
+     */
+    void set_position(int x,int y);
+    /**
+     * @brief Limits the number of rows shown.
+     *
+     * @param iRows Rows to show, or 0 to show them all.
+     */
+    void set_viewport(int iRows);
+    /**
+     * @brief Makes a row the first one shown; clamped so the viewport stays full.
+     *
+     * @param iRow Row index.
+     */
+    void scroll_to(size_t iRow);
+    /**
+     * @brief Retrieves the first row shown.
+     */
+    size_t get_scroll() const {
+        return m_iTop;
+    }
+    /**
+     * @brief Retrieves the number of screen lines render() draws.
+     */
+    int get_frame_lines();
+    /**
+     * @brief Retrieves the number of screen columns render() draws.
+     */
+    int get_frame_cols();
+    /**
+     * @brief Retrieves a number that changes whenever the drawing would.
+     */
+    uint64_t get_version() const {
+        return m_iVersion;
+    }
+    /**
+     * @brief Retrieves the number of column width rescans so far.
+     */
+    uint64_t get_scans() const {
+        return m_iScans;
+    }
+    /**
+     * @brief Draws the table with gpSemiGr: top rule, titles, a rule, the
+     * rows in the viewport and the bottom rule.
+     */
+    void render();
+};
+
+#endif //TABLE_H
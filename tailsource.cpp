@@ -0,0 +1,304 @@
+/////////////////////////////////////////////////////////////////////////////////
+// /home/doug/CLionProjects/semigraphics/tailsource.cpp 2026/10/17 12:10 dwg - //
+// Copyright (c) 2021-2026 Douglas Wade Goodall. All Rights Reserved.          //
+/////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "crtbind.h"
+#include "semigraphics.h"
+#include "surface.h"
+#include "tailsource.h"
+
+extern crtbind * gpCrt;
+extern semigraphics * gpSemiGr;
+
+/**
+ * @brief Prepares to follow a file; nothing is opened until open().
+ *
+ * @param pWin The window that receives the lines.
+ * @param ssPath The file to follow.
+ */
+tailsource::tailsource(window * pWin,std::string_view ssPath) : m_ssPath(ssPath), m_buf(CHUNK) {
+    m_pWin = pWin;
+    m_fd = -1;
+    m_iNotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    m_iWatch = -1;
+    m_iOffset = 0;
+    m_iPending = 0;
+    m_iLines = 0;
+    m_bStop = false;
+    m_bClear = false;
+}
+
+/**
+ * @brief Closes the file and the inotify descriptor.
+ */
+tailsource::~tailsource() {
+    close_file();
+    if (m_iNotify >= 0) {
+        close(m_iNotify);
+    }
+}
+
+/**
+ * @brief Opens the file.
+ *
+ * @param bFromStart Deliver the existing contents too.
+ * @return True if the file was opened.
+ */
+bool tailsource::open(bool bFromStart) {
+    close_file();
+    m_iPending = 0;
+    return open_file(!bFromStart);
+}
+
+/**
+ * @brief Opens m_ssPath and registers it with inotify.
+ *
+ * @param bAtEnd Start reading at the current end of the file.
+ * @return True if the file was opened.
+ */
+bool tailsource::open_file(bool bAtEnd) {
+    m_fd = ::open(m_ssPath.c_str(),O_RDONLY | O_CLOEXEC);
+    if (m_fd < 0) {
+        return false;
+    }
+    m_iOffset = bAtEnd ? lseek(m_fd,0,SEEK_END) : 0;
+    if (m_iNotify >= 0) {
+        m_iWatch = inotify_add_watch(m_iNotify,m_ssPath.c_str(),
+                                     IN_MODIFY | IN_ATTRIB | IN_MOVE_SELF | IN_DELETE_SELF);
+    }
+    return true;
+}
+
+/**
+ * @brief Closes the followed file and drops its inotify watch.
+ */
+void tailsource::close_file() {
+    if (m_iWatch >= 0) {
+        inotify_rm_watch(m_iNotify,m_iWatch);
+        m_iWatch = -1;
+    }
+    if (m_fd >= 0) {
+        close(m_fd);
+        m_fd = -1;
+    }
+}
+
+/**
+ * @brief Reads one chunk of whatever has been appended.
+ *
+ * The chunk lands behind any partial line left by the previous read, so a
+ * line split across reads is joined without copying it elsewhere.
+ *
+ * @return The number of bytes read; 0 when caught up.
+ */
+size_t tailsource::pump() {
+    if (m_fd < 0) {
+        if (!open_file(false)) {
+            return 0;
+        }
+    }
+    ssize_t iRead = read(m_fd,m_buf.data() + m_iPending,m_buf.size() - m_iPending);
+    if (iRead < 0) {
+        return 0;
+    }
+    if (iRead == 0) {
+        at_eof();
+        return 0;
+    }
+    m_iOffset += iRead;
+    split(m_iPending + iRead);
+    return iRead;
+}
+
+/**
+ * @brief Handles reaching the end of the file.
+ *
+ * A file now shorter than what has been read was truncated and is read
+ * again from the start. A path that now names a different file, or none,
+ * means the file was rotated: its last unterminated line is delivered and
+ * the new file is opened from the start, or on a later pump() if it does
+ * not exist yet.
+ */
+void tailsource::at_eof() {
+    struct stat stOpen;
+    struct stat stPath;
+    if (fstat(m_fd,&stOpen) != 0) {
+        return;
+    }
+    if (stOpen.st_size < m_iOffset) {
+        m_iOffset = lseek(m_fd,0,SEEK_SET);
+        m_iPending = 0;
+        return;
+    }
+    if (stat(m_ssPath.c_str(),&stPath) == 0 &&
+        stPath.st_dev == stOpen.st_dev && stPath.st_ino == stOpen.st_ino) {
+        return;
+    }
+    if (m_iPending > 0) {
+        m_pWin->add_row(std::string_view(m_buf.data(),m_iPending));
+        m_iLines++;
+        m_iPending = 0;
+    }
+    close_file();
+    open_file(false);
+}
+
+/**
+ * @brief Splits m_buf into lines and appends the complete ones to the window.
+ *
+ * Lines are passed as views into m_buf, and a "\r\n" ending loses its '\r'.
+ * The unterminated remainder moves to the front of m_buf; if it fills the
+ * whole buffer it is delivered as a row of its own.
+ *
+ * @param iLen Number of valid bytes in m_buf.
+ */
+void tailsource::split(size_t iLen) {
+    const char * pBegin = m_buf.data();
+    const char * pEnd = pBegin + iLen;
+    const char * p = pBegin;
+    while (const char * pNl = static_cast<const char *>(memchr(p,'\n',pEnd - p))) {
+        size_t iRowLen = pNl - p;
+        if (iRowLen > 0 && pNl[-1] == '\r') {
+            iRowLen--;
+        }
+        m_pWin->add_row(std::string_view(p,iRowLen));
+        m_iLines++;
+        p = pNl + 1;
+    }
+    m_iPending = pEnd - p;
+    if (m_iPending == m_buf.size()) {
+        m_pWin->add_row(std::string_view(p,m_iPending));
+        m_iLines++;
+        m_iPending = 0;
+    } else if (m_iPending > 0 && p != pBegin) {
+        memmove(m_buf.data(),p,m_iPending);
+    }
+}
+
+/**
+ * @brief Blocks until the file changes or the timeout expires.
+ *
+ * Without inotify this is a plain sleep, which turns follow() into polling
+ * at the frame interval.
+ *
+ * @param iTimeoutMs Longest wait in milliseconds.
+ */
+void tailsource::wait(int iTimeoutMs) {
+    if (m_iNotify < 0) {
+        poll(nullptr,0,iTimeoutMs);
+        return;
+    }
+    struct pollfd pfd = {m_iNotify,POLLIN,0};
+    if (poll(&pfd,1,iTimeoutMs) > 0) {
+        alignas(struct inotify_event) char events[4096];
+        while (read(m_iNotify,events,sizeof(events)) > 0) {
+        }
+    }
+}
+
+/**
+ * @brief Redraws the window and flushes the frame.
+ *
+ * With a surface attached the window is drawn into it and presented, so
+ * only changed cells are sent; otherwise it is streamed from its origin,
+ * after the screen clear a resize asked for. The frame is committed as a
+ * transaction, clear included, so it appears in one step.
+ */
+void tailsource::repaint() {
+    gpCrt->begin_frame();
+    if (m_bClear) {
+        gpCrt->crtclr();
+        m_bClear = false;
+    }
+    surface * pSurface = gpSemiGr->get_surface();
+    if (pSurface) {
+        m_pWin->render();
+        pSurface->present();
+    } else {
+        gpCrt->crtlc(m_pWin->get_y() + 1,m_pWin->get_x() + 1);
+        m_pWin->render();
+    }
+    gpCrt->end_frame();
+}
+
+/**
+ * @brief Follows the file until stop() is called.
+ *
+ * Data is read for as long as it keeps arriving; the window is repainted
+ * when a frame interval has passed and new lines have come in, so bursts
+ * collapse into one repaint each interval.
+ *
+ * A terminal resize (SIGWINCH, which also cuts a wait short) limits the
+ * window to the new screen width with window::set_max_cols() and forces a
+ * full repaint at the next frame, which also clears a streamed window's
+ * screen inside the same transaction, or resizes an attached surface to
+ * the new screen so present() repaints it at the new geometry; with wrapping enabled on the window only
+ * the rows in view are reflowed.
+ *
+ * @param iFrameMs The frame interval in milliseconds.
+ */
+void tailsource::follow(int iFrameMs) {
+    using clock = std::chrono::steady_clock;
+    const auto frame = std::chrono::milliseconds(iFrameMs);
+    auto next = clock::now();
+    size_t iPainted = SIZE_MAX;
+    crtbind::crtwatch_resize();
+    while (!m_bStop.load(std::memory_order_relaxed)) {
+        if (gpCrt->crtpoll_resize()) {
+            m_pWin->set_max_cols(gpCrt->crtcols() - m_pWin->get_x());
+            surface * pSurface = gpSemiGr->get_surface();
+            if (pSurface) {
+                // the terminal reflowed the old cells; present() repaints all
+                pSurface->resize(gpCrt->crtlines(),gpCrt->crtcols());
+            }
+            m_bClear = !pSurface;   // cleared inside repaint()'s frame
+            iPainted = SIZE_MAX;
+        }
+        size_t iRead = pump();
+        auto now = clock::now();
+        if (now >= next) {
+            if (iPainted != m_iLines) {
+                repaint();
+                iPainted = m_iLines;
+            }
+            next = now + frame;
+        }
+        if (iRead == 0) {
+            auto iWait = std::chrono::duration_cast<std::chrono::milliseconds>(next - now).count();
+            wait(static_cast<int>(std::max<long long>(iWait,0)));
+        }
+    }
+    if (iPainted != m_iLines) {
+        repaint();
+    }
+}
+
+/**
+ * @brief Makes follow() return.
+ */
+void tailsource::stop() {
+    m_bStop.store(true,std::memory_order_relaxed);
+}
+
+/**
+ * @brief Retrieves the number of lines delivered so far.
+ *
+ * @return The line count.
+ */
+size_t tailsource::get_lines() {
+    return m_iLines;
+}
+
+//////////////////////////
+// eof - tailsource.cpp //
+//////////////////////////
@@ -0,0 +1,168 @@
+///////////////////////////////////////////////////////////////////////////////
+// /home/doug/CLionProjects/semigraphics/tailsource.h 2026/10/17 12:10 dwg - //
+// Copyright (c) 2021-2026 Douglas Wade Goodall. All Rights Reserved.        //
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TAILSOURCE_H
+#define TAILSOURCE_H
+
+#include <atomic>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "window.h"
+
+/**
+ * @class tailsource
+ * @brief Follows a growing file, like `tail -f`, and feeds its lines to a window.
+ *
+ * Appended bytes are read in large chunks and split on '\n' with memchr;
+ * each complete line is handed to window::add_row() as a view into the
+ * read buffer, so no memory is allocated per line. Only a trailing partial
+ * line is carried over to the next read.
+ *
+ * Changes are detected with inotify when it is available and by polling
+ * at the frame interval otherwise. follow() reads for as long as data is
+ * waiting and repaints at most once per frame interval, so a fast writer
+ * costs read and split time only; the renderer draws the viewport once
+ * per frame however many lines arrived. Bound the window's memory with
+ * window::set_max_rows().
+ *
+ * A file that shrinks is read again from the start, and a file that is
+ * renamed or removed (log rotation) is reopened by name once the old one
+ * has been read to the end.
+ */
+class tailsource {
+    /**
+     * @brief Bytes requested per read(2).
+     */
+    static constexpr size_t CHUNK = 1 << 20;
+
+    /**
+     * @brief The window receiving the lines.
+     */
+    window * m_pWin;
+    /**
+     * @brief Path of the followed file.
+     */
+    std::string m_ssPath;
+    /**
+     * @brief Descriptor of the followed file, or -1.
+     */
+    int m_fd;
+    /**
+     * @brief inotify descriptor, or -1 when change events are unavailable.
+     */
+    int m_iNotify;
+    /**
+     * @brief inotify watch on the followed file, or -1.
+     */
+    int m_iWatch;
+    /**
+     * @brief Byte offset of the next read in the followed file.
+     */
+    off_t m_iOffset;
+    /**
+     * @brief Read buffer; the first m_iPending bytes are a partial line.
+     */
+    std::vector<char> m_buf;
+    /**
+     * @brief Length of the partial line at the front of m_buf.
+     */
+    size_t m_iPending;
+    /**
+     * @brief Total lines delivered to the window.
+     */
+    size_t m_iLines;
+    /**
+     * @brief Asks follow() to return.
+     */
+    std::atomic<bool> m_bStop;
+    /**
+     * @brief True when the next repaint() starts by clearing the screen,
+     * after a resize of a streamed window.
+     */
+    bool m_bClear;
+
+    /**
+     * @brief Opens m_ssPath and registers it with inotify.
+     *
+     * @param bAtEnd Start reading at the current end of the file.
+     * @return True if the file was opened.
+     */
+    bool open_file(bool bAtEnd);
+    /**
+     * @brief Closes the followed file and drops its inotify watch.
+     */
+    void close_file();
+    /**
+     * @brief Handles reaching the end of the file: rereads a truncated file
+     * and reopens a rotated one.
+     */
+    void at_eof();
+    /**
+     * @brief Splits m_buf into lines and appends the complete ones to the window.
+     *
+     * @param iLen Number of valid bytes in m_buf.
+     */
+    void split(size_t iLen);
+    /**
+     * @brief Redraws the window and flushes the frame.
+     */
+    void repaint();
+
+public:
+    /**
+     * @brief Prepares to follow a file.
+     *
+     * @param pWin The window that receives the lines.
+     * @param ssPath The file to follow.
+     */
+    tailsource(window * pWin,std::string_view ssPath);
+    /**
+     * @brief Closes the file and the inotify descriptor.
+     */
+    ~tailsource();
+    /**
+     * @brief Opens the file.
+     *
+     * @param bFromStart Deliver the existing contents too, rather than only
+     * what is appended from now on.
+     * @return True if the file was opened.
+     */
+    bool open(bool bFromStart = false);
+    /**
+     * @brief Reads one chunk of whatever has been appended.
+     *
+     * Handles truncation and rotation when the end of the file is reached.
+     *
+     * @return The number of bytes read; 0 when caught up.
+     */
+    size_t pump();
+    /**
+     * @brief Blocks until the file changes or the timeout expires.
+     *
+     * @param iTimeoutMs Longest wait in milliseconds.
+     */
+    void wait(int iTimeoutMs);
+    /**
+     * @brief Follows the file until stop() is called, repainting the window
+     * at most once per frame interval.
+     *
+     * @param iFrameMs The frame interval in milliseconds.
+     */
+    void follow(int iFrameMs = 16);
+    /**
+     * @brief Makes follow() return; safe to call from another thread.
+     */
+    void stop();
+    /**
+     * @brief Retrieves the number of lines delivered so far.
+     */
+    size_t get_lines();
+};
+
+#endif //TAILSOURCE_H
+
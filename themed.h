@@ -0,0 +1,286 @@
+//////////////////////////////////////////////////////////////////////////////
+// /home/doug/CLionProjects/semigraphics/themed.h    2026/10/17 10:35 dwg - //
+// Copyright (c) 2021-2026 Douglas Wade Goodall. All Rights Reserved.       //
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef THEMED_H
+#define THEMED_H
+
+#include <array>
+#include <cstddef>
+#include <string_view>
+#include <utility>
+
+#include "semigraphics.h"
+#include "surface.h"
+#include "utf8width.h"
+
+/**
+ * @brief Global pointer to the crtbind instance that owns the frame buffer.
+ */
+extern crtbind * gpCrt;
+/**
+ * @brief Global pointer to the semigraphics engine; its binding and surface
+ * are the ones themed output goes to.
+ */
+extern semigraphics * gpSemiGr;
+
+// Theme types: each names one of the constexpr THEME_* glyph tables.
+struct theme_rounded { static constexpr const theme & glyphs = THEME_ROUNDED; };
+struct theme_square  { static constexpr const theme & glyphs = THEME_SQUARE;  };
+struct theme_double  { static constexpr const theme & glyphs = THEME_DOUBLE;  };
+struct theme_dhsv    { static constexpr const theme & glyphs = THEME_DHSV;    };
+struct theme_shdv    { static constexpr const theme & glyphs = THEME_SHDV;    };
+
+/**
+ * @class themed_semigraphics
+ * @brief The semigraphics primitives specialised for one theme at compile time.
+ *
+ * Theme is a type with a constexpr `glyphs` member (see theme_rounded and
+ * friends). Every glyph is a compile-time constant, so there is no theme
+ * pointer to follow. Horizontal runs are copied from a pre-encoded block of
+ * RUN line glyphs, and border rows for a width known at compile time are
+ * generated whole by the Width-templated overloads.
+ *
+ * Output goes where gpSemiGr's would: into its surface when one is set
+ * (placed by line and col), otherwise streamed at the cursor into the
+ * binding from semigraphics::get_crt(), so a window's memo or a redirected
+ * binding receives it. Streamed output is byte-identical to semigraphics
+ * drawing the same theme. When the terminal has CAP_REP the runs are left
+ * to crtbind::crtrepeat(), which is shorter on the wire.
+ */
+template <class Theme>
+class themed_semigraphics {
+    /**
+     * @brief The glyph table, resolved at compile time.
+     */
+    static constexpr const theme & T = Theme::glyphs;
+    /**
+     * @brief Number of line glyphs in the pre-encoded run.
+     */
+    static constexpr int RUN = 64;
+
+    /**
+     * @brief Encodes iCount horizontal line glyphs into a fixed-size array.
+     */
+    template <int iCount>
+    static constexpr auto encode_run() {
+        std::array<char,iCount * T.g[GLYPH_HL].len> run{};
+        size_t iPos = 0;
+        for (int i = 0; i < iCount; i++) {
+            for (unsigned b = 0; b < T.g[GLYPH_HL].len; b++) {
+                run[iPos++] = T.g[GLYPH_HL].utf8[b];
+            }
+        }
+        return run;
+    }
+
+    /**
+     * @brief Encodes a complete border row: left glyph, Width-3 line glyphs,
+     * right glyph. Returns the bytes and how many of them are used.
+     */
+    template <int Width>
+    static constexpr auto encode_row(GLYPH_T left, GLYPH_T right) {
+        std::array<char,2 * sizeof(glyph::utf8) + (Width - 3) * T.g[GLYPH_HL].len> row{};
+        size_t iPos = 0;
+        auto put = [&](const glyph & gl) {
+            for (unsigned b = 0; b < gl.len; b++) {
+                row[iPos++] = gl.utf8[b];
+            }
+        };
+        put(T.g[left]);
+        for (int i = 0; i < Width - 3; i++) {
+            put(T.g[GLYPH_HL]);
+        }
+        put(T.g[right]);
+        return std::pair(row,iPos);
+    }
+
+    /**
+     * @brief RUN horizontal line glyphs, pre-encoded.
+     */
+    static constexpr auto s_hlRun = encode_run<RUN>();
+
+    /**
+     * @brief Pre-encoded top, splitter and bottom rows for a fixed width.
+     */
+    template <int Width> static constexpr auto s_top = encode_row<Width>(GLYPH_UL,GLYPH_UR);
+    template <int Width> static constexpr auto s_split = encode_row<Width>(GLYPH_VSR,GLYPH_VSL);
+    template <int Width> static constexpr auto s_end = encode_row<Width>(GLYPH_LL,GLYPH_LR);
+
+    /**
+     * @brief The binding streamed output goes to.
+     */
+    static crtbind * crt() {
+        return gpSemiGr ? gpSemiGr->get_crt() : gpCrt;
+    }
+
+    /**
+     * @brief The surface drawn into instead, or nullptr.
+     */
+    static surface * target() {
+        return gpSemiGr ? gpSemiGr->get_surface() : nullptr;
+    }
+
+    /**
+     * @brief Draws a border row into a surface, as semigraphics does.
+     */
+    static void surface_row(surface * pSurface, int line, int col, GLYPH_T left, GLYPH_T right, int width) {
+        if (!pSurface->visible(line,col,1,width-1)) {
+            return;
+        }
+        pSurface->put(line,col,T.g[left].bytes());
+        pSurface->repeat(line,col+1,T.g[GLYPH_HL].bytes(),width-3);
+        pSurface->put(line,col+width-2,T.g[right].bytes());
+    }
+
+    /**
+     * @brief Emits one glyph.
+     */
+    static void put(GLYPH_T id) {
+        crt()->crtputcells(T.g[id].bytes(),1);
+    }
+
+    /**
+     * @brief Emits iCount horizontal line glyphs.
+     */
+    static void hline(int iCount) {
+        if (iCount <= 0) {
+            return;
+        }
+        crtbind * pCrt = crt();
+        if (pCrt->crtcaps() & CAP_REP) {
+            pCrt->crtrepeat(T.g[GLYPH_HL].bytes(),iCount);
+            return;
+        }
+        constexpr int iLen = T.g[GLYPH_HL].len;
+        for (; iCount >= RUN; iCount -= RUN) {
+            pCrt->crtputcells(std::string_view(s_hlRun.data(),s_hlRun.size()),RUN);
+        }
+        pCrt->crtputcells(std::string_view(s_hlRun.data(),iCount * iLen),iCount);
+    }
+
+    /**
+     * @brief Draws a border row of run-time width.
+     */
+    static void row(int line, int col, GLYPH_T left, GLYPH_T right, int width) {
+        if (surface * pSurface = target()) {
+            surface_row(pSurface,line,col,left,right,width);
+            return;
+        }
+        put(left);
+        hline(width-3);
+        put(right);
+        crt()->crtputs("\n");
+    }
+
+    /**
+     * @brief Draws a border row generated at compile time; falls back to
+     * the run-time row for a surface or a terminal with CAP_REP.
+     */
+    template <auto & Row, int Width>
+    static void row(int line, int col, GLYPH_T left, GLYPH_T right) {
+        crtbind * pCrt = crt();
+        if (target() || (pCrt->crtcaps() & CAP_REP)) {
+            row(line,col,left,right,Width);
+            return;
+        }
+        pCrt->crtputcells(std::string_view(Row.first.data(),Row.second),Width-1);
+        pCrt->crtputs("\n");
+    }
+
+public:
+    /**
+     * Draws the top border of a box of run-time width.
+     *
+     * @param line 1-based screen line; used when drawing into a surface.
+     * @param col 1-based screen column; used when drawing into a surface.
+     * @param width The width of the box, as for semigraphics::topline().
+     * @param height Unused.
+     */
+    static void topline(int line, int col, int width, int) {
+        row(line,col,GLYPH_UL,GLYPH_UR,width);
+    }
+    /**
+     * Draws a splitter row of run-time width.
+     */
+    static void vert_splitter(int line, int col, int width, int) {
+        row(line,col,GLYPH_VSR,GLYPH_VSL,width);
+    }
+    /**
+     * Draws the bottom border of a box of run-time width.
+     */
+    static void endline(int line, int col, int width, int) {
+        row(line,col,GLYPH_LL,GLYPH_LR,width);
+    }
+    /**
+     * Draws a content line padded to the box width.
+     *
+     * @param ssText The text between the vertical borders.
+     */
+    static void middleline(int line, int col, int width, int, std::string_view ssText) {
+        if (surface * pSurface = target()) {
+            if (!pSurface->visible(line,col,1,width-1)) {
+                return;
+            }
+            pSurface->put(line,col,T.g[GLYPH_VL].bytes());
+            int textlen = pSurface->puts(line,col+1,ssText);
+            if (textlen < width-3) {
+                pSurface->repeat(line,col+1+textlen," ",width-3-textlen);
+                textlen = width-3;
+            }
+            pSurface->put(line,col+1+textlen,T.g[GLYPH_VL].bytes());
+            return;
+        }
+        crtbind * pCrt = crt();
+        put(GLYPH_VL);
+        pCrt->crtputs(ssText);
+        int textlen = utf8_width(ssText);
+        if (textlen < width-3) {
+            pCrt->crtpad(width-3-textlen);
+        }
+        put(GLYPH_VL);
+        pCrt->crtputs("\n");
+    }
+    /**
+     * Draws the top border of a box whose width is a compile-time constant.
+     *
+     * The whole row is a single pre-encoded block.
+     *
+     * @param line 1-based screen line; used when drawing into a surface.
+     * @param col 1-based screen column; used when drawing into a surface.
+     */
+    template <int Width>
+    static void topline(int line, int col) {
+        static_assert(Width >= 3,"a box needs room for two corners");
+        row<s_top<Width>,Width>(line,col,GLYPH_UL,GLYPH_UR);
+    }
+    /**
+     * Draws a splitter row whose width is a compile-time constant.
+     */
+    template <int Width>
+    static void vert_splitter(int line, int col) {
+        static_assert(Width >= 3,"a box needs room for two corners");
+        row<s_split<Width>,Width>(line,col,GLYPH_VSR,GLYPH_VSL);
+    }
+    /**
+     * Draws the bottom border of a box whose width is a compile-time constant.
+     */
+    template <int Width>
+    static void endline(int line, int col) {
+        static_assert(Width >= 3,"a box needs room for two corners");
+        row<s_end<Width>,Width>(line,col,GLYPH_LL,GLYPH_LR);
+    }
+    /**
+     * Sets the style of the glyphs drawn next.
+     */
+    static void style(MODE_T mode, FG_COLORS_T fg, BG_COLORS_T bg) {
+        if (gpSemiGr) {
+            gpSemiGr->style(mode,fg,bg);    // sets the surface pen in surface mode
+            return;
+        }
+        gpCrt->crtstyle(mode,fg,bg);
+    }
+};
+
+#endif //THEMED_H
@@ -0,0 +1,155 @@
+/////////////////////////////////////////////////////////////////////////////////
+// /home/doug/CLionProjects/semigraphics/threadpool.cpp 2026/10/17 13:30 dwg - //
+// Copyright (c) 2021-2026 Douglas Wade Goodall. All Rights Reserved.          //
+/////////////////////////////////////////////////////////////////////////////////
+
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "threadpool.h"
+
+/**
+ * @brief Starts the workers; they sleep until parallel_for() posts work.
+ *
+ * @param iThreads Worker threads besides the caller.
+ */
+threadpool::threadpool(unsigned iThreads) {
+    m_pFn = nullptr;
+    m_iGeneration = 0;
+    m_iRemaining = 0;
+    m_bStop = false;
+    for (unsigned i = 0; i <= iThreads; i++) {
+        m_queues.push_back(std::make_unique<queue>());
+    }
+    for (unsigned i = 1; i <= iThreads; i++) {
+        m_threads.emplace_back(&threadpool::worker,this,i);
+    }
+}
+
+/**
+ * @brief Stops and joins the workers.
+ */
+threadpool::~threadpool() {
+    {
+        std::lock_guard<std::mutex> lock(m_mtx);
+        m_bStop = true;
+    }
+    m_cvWork.notify_all();
+    for (std::thread & t : m_threads) {
+        t.join();
+    }
+}
+
+/**
+ * @brief Takes a task from the back of the own queue, or steals one from
+ * the front of another queue.
+ *
+ * @param iSelf The participant's own queue.
+ * @param iTask Receives the task index.
+ * @return False when every queue is empty.
+ */
+bool threadpool::take(size_t iSelf, size_t & iTask) {
+    size_t iQueues = m_queues.size();
+    for (size_t i = 0; i < iQueues; i++) {
+        queue & q = *m_queues[(iSelf + i) % iQueues];
+        std::lock_guard<std::mutex> lock(q.mtx);
+        if (q.tasks.empty()) {
+            continue;
+        }
+        if (i == 0) {
+            iTask = q.tasks.back();
+            q.tasks.pop_back();
+        } else {
+            iTask = q.tasks.front();
+            q.tasks.pop_front();
+        }
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Runs tasks until none are left, signalling when the batch completes.
+ *
+ * @param iSelf The participant's own queue.
+ */
+void threadpool::work(size_t iSelf) {
+    size_t iTask;
+    while (take(iSelf,iTask)) {
+        (*m_pFn)(iTask);
+        if (m_iRemaining.fetch_sub(1,std::memory_order_acq_rel) == 1) {
+            std::lock_guard<std::mutex> lock(m_mtx);
+            m_cvDone.notify_one();
+        }
+    }
+}
+
+/**
+ * @brief Waits for each new batch and helps run it.
+ *
+ * @param iSelf The worker's queue.
+ */
+void threadpool::worker(size_t iSelf) {
+    uint64_t iSeen = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(m_mtx);
+            m_cvWork.wait(lock,[&] { return m_bStop || m_iGeneration != iSeen; });
+            if (m_bStop) {
+                return;
+            }
+            iSeen = m_iGeneration;
+        }
+        work(iSelf);
+    }
+}
+
+/**
+ * @brief Runs fn over [0, iCount) on every participant and waits for completion.
+ *
+ * @param iCount Number of tasks.
+ * @param fn The task body.
+ */
+void threadpool::parallel_for(size_t iCount, const std::function<void(size_t)> & fn) {
+    if (iCount == 0) {
+        return;
+    }
+    if (m_threads.empty() || iCount == 1) {
+        for (size_t i = 0; i < iCount; i++) {
+            fn(i);
+        }
+        return;
+    }
+    m_pFn = &fn;
+    m_iRemaining.store(iCount,std::memory_order_relaxed);
+    size_t iQueues = m_queues.size();
+    for (size_t q = 0; q < iQueues; q++) {
+        std::lock_guard<std::mutex> lock(m_queues[q]->mtx);
+        // owners pop from the back, so store each block in reverse
+        for (size_t i = iCount * (q + 1) / iQueues; i > iCount * q / iQueues; i--) {
+            m_queues[q]->tasks.push_back(i - 1);
+        }
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_mtx);
+        m_iGeneration++;
+    }
+    m_cvWork.notify_all();
+    work(0);
+    std::unique_lock<std::mutex> lock(m_mtx);
+    m_cvDone.wait(lock,[&] { return m_iRemaining.load(std::memory_order_acquire) == 0; });
+}
+
+/**
+ * @brief Retrieves the number of participants, the caller included.
+ *
+ * @return Worker threads plus one.
+ */
+unsigned threadpool::size() const {
+    return static_cast<unsigned>(m_queues.size());
+}
+
+//////////////////////////
+// eof - threadpool.cpp //
+//////////////////////////
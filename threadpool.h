@@ -0,0 +1,127 @@
+///////////////////////////////////////////////////////////////////////////////
+// /home/doug/CLionProjects/semigraphics/threadpool.h 2026/10/17 13:30 dwg - //
+// Copyright (c) 2021-2026 Douglas Wade Goodall. All Rights Reserved.        //
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @class threadpool
+ * @brief A fixed set of worker threads that run indexed tasks by work stealing.
+ *
+ * parallel_for() deals the task indices out as contiguous blocks, one
+ * queue per participant; the calling thread takes part as well. Each
+ * participant works from the back of its own queue and, once that is
+ * empty, steals from the front of the others. This keeps neighbouring
+ * tasks on one core and still balances uneven ones.
+ */
+class threadpool {
+    /**
+     * @brief One participant's task indices.
+     */
+    struct queue {
+        std::mutex mtx;
+        std::deque<size_t> tasks;
+    };
+
+    /**
+     * @brief The worker threads.
+     */
+    std::vector<std::thread> m_threads;
+    /**
+     * @brief Queue per participant; index 0 belongs to the calling thread.
+     */
+    std::vector<std::unique_ptr<queue>> m_queues;
+    /**
+     * @brief Guards m_iGeneration and m_bStop and backs the condition variables.
+     */
+    std::mutex m_mtx;
+    /**
+     * @brief Wakes the workers when a batch is posted or the pool stops.
+     */
+    std::condition_variable m_cvWork;
+    /**
+     * @brief Wakes parallel_for() when the last task of a batch finishes.
+     */
+    std::condition_variable m_cvDone;
+    /**
+     * @brief The task body of the current batch.
+     */
+    const std::function<void(size_t)> * m_pFn;
+    /**
+     * @brief Counts batches so that workers notice new ones.
+     */
+    uint64_t m_iGeneration;
+    /**
+     * @brief Tasks of the current batch not yet finished.
+     */
+    std::atomic<size_t> m_iRemaining;
+    /**
+     * @brief Tells the workers to exit.
+     */
+    bool m_bStop;
+
+    /**
+     * @brief Takes a task from queue iSelf, or steals one from another queue.
+     *
+     * @param iSelf The participant's own queue.
+     * @param iTask Receives the task index.
+     * @return False when every queue is empty.
+     */
+    bool take(size_t iSelf,size_t & iTask);
+    /**
+     * @brief Runs tasks until none are left.
+     *
+     * @param iSelf The participant's own queue.
+     */
+    void work(size_t iSelf);
+    /**
+     * @brief Body of each worker thread.
+     *
+     * @param iSelf The worker's queue.
+     */
+    void worker(size_t iSelf);
+
+public:
+    /**
+     * @brief Starts the workers.
+     *
+     * @param iThreads Worker threads besides the caller; defaults to one per
+     * remaining hardware thread.
+     */
+    explicit threadpool(unsigned iThreads = std::max(std::thread::hardware_concurrency(),1u) - 1);
+    /**
+     * @brief Stops and joins the workers.
+     */
+    ~threadpool();
+    threadpool(const threadpool &) = delete;
+    threadpool & operator=(const threadpool &) = delete;
+    /**
+     * @brief Runs fn(0) .. fn(iCount-1) across the pool and waits for all of them.
+     *
+     * Only one thread may call parallel_for() at a time.
+     *
+     * @param iCount Number of tasks.
+     * @param fn The task body.
+     */
+    void parallel_for(size_t iCount,const std::function<void(size_t)> & fn);
+    /**
+     * @brief Retrieves the number of participants, the caller included.
+     */
+    unsigned size() const;
+};
+
+#endif //THREADPOOL_H
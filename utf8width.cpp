@@ -0,0 +1,334 @@
+////////////////////////////////////////////////////////////////////////////////
+// /home/doug/CLionProjects/semigraphics/utf8width.cpp 2026/10/17 11:05 dwg - //
+// Copyright (c) 2021-2026 Douglas Wade Goodall. All Rights Reserved.         //
+////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <vector>
+
+#include "utf8width.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/**
+ * @brief An inclusive range of code points.
+ */
+struct cprange {
+    char32_t first;
+    char32_t last;
+};
+
+/**
+ * @brief Combining marks, format controls and other zero-width code points.
+ *
+ * Sorted; applied after s_wide so that marks inside wide blocks (such as
+ * the kana voicing marks) stay zero-width.
+ */
+static constexpr cprange s_zero[] = {
+    {0x0300,0x036F},{0x0483,0x0489},{0x0591,0x05BD},{0x05BF,0x05BF},
+    {0x05C1,0x05C2},{0x05C4,0x05C5},{0x05C7,0x05C7},{0x0610,0x061A},
+    {0x061C,0x061C},{0x064B,0x065F},{0x0670,0x0670},{0x06D6,0x06DC},
+    {0x06DF,0x06E4},{0x06E7,0x06E8},{0x06EA,0x06ED},{0x0711,0x0711},
+    {0x0730,0x074A},{0x07A6,0x07B0},{0x07EB,0x07F3},{0x0816,0x0819},
+    {0x081B,0x0823},{0x0825,0x0827},{0x0829,0x082D},{0x0859,0x085B},
+    {0x08D3,0x08E1},{0x08E3,0x0902},{0x093A,0x093A},{0x093C,0x093C},
+    {0x0941,0x0948},{0x094D,0x094D},{0x0951,0x0957},{0x0962,0x0963},
+    {0x0981,0x0981},{0x09BC,0x09BC},{0x09C1,0x09C4},{0x09CD,0x09CD},
+    {0x09E2,0x09E3},{0x0A01,0x0A02},{0x0A3C,0x0A3C},{0x0A41,0x0A51},
+    {0x0A70,0x0A71},{0x0A75,0x0A75},{0x0A81,0x0A82},{0x0ABC,0x0ABC},
+    {0x0AC1,0x0AC8},{0x0ACD,0x0ACD},{0x0AE2,0x0AE3},{0x0B01,0x0B01},
+    {0x0B3C,0x0B3C},{0x0B3F,0x0B3F},{0x0B41,0x0B44},{0x0B4D,0x0B4D},
+    {0x0B56,0x0B56},{0x0B62,0x0B63},{0x0B82,0x0B82},{0x0BC0,0x0BC0},
+    {0x0BCD,0x0BCD},{0x0C00,0x0C00},{0x0C3E,0x0C40},{0x0C46,0x0C56},
+    {0x0C62,0x0C63},{0x0CBC,0x0CBC},{0x0CCC,0x0CCD},{0x0CE2,0x0CE3},
+    {0x0D00,0x0D01},{0x0D41,0x0D44},{0x0D4D,0x0D4D},{0x0D62,0x0D63},
+    {0x0DCA,0x0DCA},{0x0DD2,0x0DD6},{0x0E31,0x0E31},{0x0E34,0x0E3A},
+    {0x0E47,0x0E4E},{0x0EB1,0x0EB1},{0x0EB4,0x0EBC},{0x0EC8,0x0ECD},
+    {0x0F18,0x0F19},{0x0F35,0x0F35},{0x0F37,0x0F37},{0x0F39,0x0F39},
+    {0x0F71,0x0F7E},{0x0F80,0x0F84},{0x0F86,0x0F87},{0x0F8D,0x0FBC},
+    {0x0FC6,0x0FC6},{0x102D,0x1030},{0x1032,0x1037},{0x1039,0x103A},
+    {0x103D,0x103E},{0x1058,0x1059},{0x105E,0x1060},{0x1071,0x1074},
+    {0x1082,0x1082},{0x1085,0x1086},{0x108D,0x108D},{0x109D,0x109D},
+    {0x1160,0x11FF},{0x135D,0x135F},{0x1712,0x1714},{0x1732,0x1734},
+    {0x1752,0x1753},{0x1772,0x1773},{0x17B4,0x17B5},{0x17B7,0x17BD},
+    {0x17C6,0x17C6},{0x17C9,0x17D3},{0x17DD,0x17DD},{0x180B,0x180E},
+    {0x18A9,0x18A9},{0x1920,0x1922},{0x1927,0x1928},{0x1932,0x1932},
+    {0x1939,0x193B},{0x1A17,0x1A18},{0x1A1B,0x1A1B},{0x1A56,0x1A56},
+    {0x1A58,0x1A7F},{0x1AB0,0x1AFF},{0x1B00,0x1B03},{0x1B34,0x1B34},
+    {0x1B36,0x1B3A},{0x1B3C,0x1B3C},{0x1B42,0x1B42},{0x1B6B,0x1B73},
+    {0x1DC0,0x1DFF},{0x200B,0x200F},{0x202A,0x202E},{0x2060,0x2064},
+    {0x20D0,0x20F0},{0x2CEF,0x2CF1},{0x2D7F,0x2D7F},{0x2DE0,0x2DFF},
+    {0x302A,0x302D},{0x3099,0x309A},{0xA66F,0xA672},{0xA674,0xA67D},
+    {0xA69E,0xA69F},{0xA6F0,0xA6F1},{0xA802,0xA802},{0xA806,0xA806},
+    {0xA80B,0xA80B},{0xA825,0xA826},{0xA8C4,0xA8C5},{0xA8E0,0xA8F1},
+    {0xA926,0xA92D},{0xA947,0xA951},{0xA980,0xA982},{0xA9B3,0xA9B3},
+    {0xA9B6,0xA9B9},{0xA9BC,0xA9BC},{0xAA29,0xAA2E},{0xAA31,0xAA32},
+    {0xAA35,0xAA36},{0xAA43,0xAA43},{0xAA4C,0xAA4C},{0xAAB0,0xAAB0},
+    {0xAAB2,0xAAB4},{0xAAB7,0xAAB8},{0xAABE,0xAABF},{0xAAC1,0xAAC1},
+    {0xAAEC,0xAAED},{0xAAF6,0xAAF6},{0xABE5,0xABE5},{0xABE8,0xABE8},
+    {0xABED,0xABED},{0xFB1E,0xFB1E},{0xFE00,0xFE0F},{0xFE20,0xFE2F},
+    {0xFEFF,0xFEFF},{0xFFF9,0xFFFB},
+    {0x1D167,0x1D169},{0x1D173,0x1D182},{0x1D185,0x1D18B},{0x1D1AA,0x1D1AD},
+    {0x1F3FB,0x1F3FF},{0xE0001,0xE007F},{0xE0100,0xE01EF},
+};
+
+/**
+ * @brief East Asian wide and fullwidth blocks and wide emoji. Sorted.
+ */
+static constexpr cprange s_wide[] = {
+    {0x1100,0x115F},{0x231A,0x231B},{0x2329,0x232A},{0x23E9,0x23EC},
+    {0x23F0,0x23F0},{0x23F3,0x23F3},{0x25FD,0x25FE},{0x2614,0x2615},
+    {0x2648,0x2653},{0x267F,0x267F},{0x2693,0x2693},{0x26A1,0x26A1},
+    {0x26AA,0x26AB},{0x26BD,0x26BE},{0x26C4,0x26C5},{0x26CE,0x26CE},
+    {0x26D4,0x26D4},{0x26EA,0x26EA},{0x26F2,0x26F3},{0x26F5,0x26F5},
+    {0x26FA,0x26FA},{0x26FD,0x26FD},{0x2705,0x2705},{0x270A,0x270B},
+    {0x2728,0x2728},{0x274C,0x274C},{0x274E,0x274E},{0x2753,0x2755},
+    {0x2757,0x2757},{0x2795,0x2797},{0x27B0,0x27B0},{0x27BF,0x27BF},
+    {0x2B1B,0x2B1C},{0x2B50,0x2B50},{0x2B55,0x2B55},{0x2E80,0x303E},
+    {0x3041,0x33FF},{0x3400,0x4DBF},{0x4E00,0x9FFF},{0xA000,0xA4CF},
+    {0xA960,0xA97F},{0xAC00,0xD7A3},{0xF900,0xFAFF},{0xFE10,0xFE19},
+    {0xFE30,0xFE6F},{0xFF00,0xFF60},{0xFFE0,0xFFE6},
+    {0x16FE0,0x16FE4},{0x17000,0x18CFF},{0x1B000,0x1B2FF},{0x1F004,0x1F004},
+    {0x1F0CF,0x1F0CF},{0x1F18E,0x1F18E},{0x1F191,0x1F19A},{0x1F200,0x1F251},
+    {0x1F300,0x1F320},{0x1F32D,0x1F335},{0x1F337,0x1F37C},{0x1F37E,0x1F393},
+    {0x1F3A0,0x1F3CA},{0x1F3CF,0x1F3D3},{0x1F3E0,0x1F3F0},{0x1F3F4,0x1F3F4},
+    {0x1F3F8,0x1F43E},{0x1F440,0x1F440},{0x1F442,0x1F4FC},{0x1F4FF,0x1F53D},
+    {0x1F54B,0x1F54E},{0x1F550,0x1F567},{0x1F57A,0x1F57A},{0x1F595,0x1F596},
+    {0x1F5A4,0x1F5A4},{0x1F5FB,0x1F64F},{0x1F680,0x1F6C5},{0x1F6CC,0x1F6CC},
+    {0x1F6D0,0x1F6D2},{0x1F6D5,0x1F6D7},{0x1F6EB,0x1F6EC},{0x1F6F4,0x1F6FC},
+    {0x1F7E0,0x1F7EB},{0x1F90C,0x1F93A},{0x1F93C,0x1F945},{0x1F947,0x1F9FF},
+    {0x1FA70,0x1FAFF},{0x20000,0x2FFFD},{0x30000,0x3FFFD},
+};
+
+/**
+ * @class bmpwidths
+ * @brief Two-level lookup table of widths for the Basic Multilingual Plane.
+ *
+ * The plane is split into 256 pages of 256 code points. Each page maps to
+ * a 64-byte block of 2-bit widths, and identical pages share one block, so
+ * the whole plane takes a few kilobytes and a lookup is two loads.
+ */
+class bmpwidths {
+    /**
+     * @brief Block index for each page.
+     */
+    uint8_t m_page[256];
+    /**
+     * @brief Distinct blocks of 256 packed 2-bit widths.
+     */
+    std::vector<std::array<uint8_t,64>> m_blocks;
+
+public:
+    /**
+     * @brief Builds the table from s_zero and s_wide.
+     */
+    bmpwidths() {
+        std::vector<uint8_t> widths(0x10000,1);
+        for (char32_t cp = 0; cp < 0x20; cp++) {
+            widths[cp] = 0;
+        }
+        for (char32_t cp = 0x7F; cp < 0xA0; cp++) {
+            widths[cp] = 0;
+        }
+        for (const cprange & r : s_wide) {
+            for (char32_t cp = r.first; cp <= r.last && cp < 0x10000; cp++) {
+                widths[cp] = 2;
+            }
+        }
+        for (const cprange & r : s_zero) {
+            for (char32_t cp = r.first; cp <= r.last && cp < 0x10000; cp++) {
+                widths[cp] = 0;
+            }
+        }
+        for (int iPage = 0; iPage < 256; iPage++) {
+            std::array<uint8_t,64> block{};
+            for (int i = 0; i < 256; i++) {
+                block[i >> 2] |= widths[iPage * 256 + i] << ((i & 3) * 2);
+            }
+            auto it = std::find(m_blocks.begin(),m_blocks.end(),block);
+            m_page[iPage] = static_cast<uint8_t>(it - m_blocks.begin());
+            if (it == m_blocks.end()) {
+                m_blocks.push_back(block);
+            }
+        }
+    }
+
+    /**
+     * @brief Looks up the width of a BMP code point.
+     *
+     * @param cp A code point below U+10000.
+     * @return 0, 1 or 2.
+     */
+    int width(char32_t cp) const {
+        uint8_t packed = m_blocks[m_page[cp >> 8]][(cp & 0xFF) >> 2];
+        return (packed >> ((cp & 3) * 2)) & 3;
+    }
+};
+
+/**
+ * @brief Returns the lazily built BMP table.
+ */
+static const bmpwidths & bmp_table() {
+    static const bmpwidths table;
+    return table;
+}
+
+/**
+ * @brief Tests whether a code point falls in a sorted range list.
+ */
+template <size_t N>
+static bool in_ranges(const cprange (&ranges)[N], char32_t cp) {
+    const cprange * pEnd = ranges + N;
+    const cprange * p = std::upper_bound(ranges,pEnd,cp,
+        [](char32_t value, const cprange & r) { return value < r.first; });
+    return p != ranges && cp <= (p - 1)->last;
+}
+
+/**
+ * @brief Decodes one UTF-8 sequence.
+ *
+ * @param ssText The text.
+ * @param i Offset of the lead byte.
+ * @param cp Receives the code point, U+FFFD when malformed.
+ * @return The number of bytes consumed.
+ */
+size_t utf8_decode(std::string_view ssText, size_t i, char32_t & cp) {
+    unsigned char ch = ssText[i];
+    size_t iLen = utf8_seqlen(ch);
+    if (iLen == 1) {
+        cp = ch < 0x80 ? ch : 0xFFFD;
+        return 1;
+    }
+    if (i + iLen > ssText.size()) {
+        cp = 0xFFFD;
+        return 1;
+    }
+    char32_t value = ch & (0x7F >> iLen);
+    for (size_t k = 1; k < iLen; k++) {
+        unsigned char cont = ssText[i + k];
+        if ((cont & 0xC0) != 0x80) {
+            cp = 0xFFFD;
+            return 1;
+        }
+        value = (value << 6) | (cont & 0x3F);
+    }
+    cp = value;
+    return iLen;
+}
+
+/**
+ * @brief Returns the display width of a code point.
+ *
+ * @param cp The code point.
+ * @return 0, 1 or 2.
+ */
+int cp_width(char32_t cp) {
+    if (cp < 0x10000) {
+        return bmp_table().width(cp);
+    }
+    if (in_ranges(s_zero,cp)) {
+        return 0;
+    }
+    return in_ranges(s_wide,cp) ? 2 : 1;
+}
+
+/**
+ * @brief Returns the display width of UTF-8 text.
+ *
+ * @param ssText The text.
+ * @return The width in columns.
+ */
+int utf8_width(std::string_view ssText) {
+    const char * p = ssText.data();
+    size_t n = ssText.size();
+    size_t i = 0;
+    int iWidth = 0;
+    while (i < n) {
+#if defined(__SSE2__)
+        // 16 bytes at a time while every byte is printable ASCII (0x20-0x7E)
+        const __m128i vLow = _mm_set1_epi8(0x1F);
+        const __m128i vDel = _mm_set1_epi8(0x7F);
+        while (i + 16 <= n) {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + i));
+            __m128i vOk = _mm_andnot_si128(_mm_cmpeq_epi8(v,vDel),_mm_cmpgt_epi8(v,vLow));
+            if (_mm_movemask_epi8(vOk) != 0xFFFF) {
+                break;
+            }
+            i += 16;
+            iWidth += 16;
+        }
+#endif
+        // 8 bytes at a time, portable
+        while (i + 8 <= n) {
+            uint64_t x;
+            std::memcpy(&x,p + i,8);
+            constexpr uint64_t HI = 0x8080808080808080ULL;
+            constexpr uint64_t ONES = 0x0101010101010101ULL;
+            uint64_t uHigh = x & HI;
+            uint64_t uCtl = (x - ONES * 0x20) & ~x & HI;
+            uint64_t y = x ^ (ONES * 0x7F);
+            uint64_t uDel = (y - ONES) & ~y & HI;
+            if (uHigh | uCtl | uDel) {
+                break;
+            }
+            i += 8;
+            iWidth += 8;
+        }
+        if (i >= n) {
+            break;
+        }
+        unsigned char ch = p[i];
+        if (ch >= 0x20 && ch < 0x7F) {
+            iWidth++;
+            i++;
+            continue;
+        }
+        char32_t cp;
+        i += utf8_decode(ssText,i,cp);
+        iWidth += cp_width(cp);
+    }
+    return iWidth;
+}
+
+/**
+ * @brief Returns the byte length of the widest prefix within iCols columns.
+ *
+ * Printable ASCII is taken a byte at a time without decoding.
+ *
+ * @param ssText The text.
+ * @param iCols The column limit.
+ * @param iWidth Receives the prefix width.
+ * @return The prefix length in bytes.
+ */
+size_t utf8_fit(std::string_view ssText, int iCols, int & iWidth) {
+    size_t i = 0;
+    iWidth = 0;
+    while (i < ssText.size()) {
+        unsigned char ch = ssText[i];
+        if (ch >= 0x20 && ch < 0x7F) {
+            if (iWidth + 1 > iCols) {
+                break;
+            }
+            iWidth++;
+            i++;
+            continue;
+        }
+        char32_t cp;
+        size_t iLen = utf8_decode(ssText,i,cp);
+        int w = cp_width(cp);
+        if (iWidth + w > iCols) {
+            break;
+        }
+        iWidth += w;
+        i += iLen;
+    }
+    return i;
+}
+
+/////////////////////////
+// eof - utf8width.cpp //
+/////////////////////////
@@ -0,0 +1,86 @@
+//////////////////////////////////////////////////////////////////////////////
+// /home/doug/CLionProjects/semigraphics/utf8width.h 2026/10/17 11:05 dwg - //
+// Copyright (c) 2021-2026 Douglas Wade Goodall. All Rights Reserved.       //
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef UTF8WIDTH_H
+#define UTF8WIDTH_H
+
+#include <cstddef>
+#include <string_view>
+
+/**
+ * @brief Returns the length of the UTF-8 sequence introduced by a lead byte.
+ *
+ * Stray continuation bytes and invalid lead bytes are treated as one-byte
+ * sequences so that malformed input still advances.
+ *
+ * @param ch The lead byte.
+ * @return The sequence length, from 1 to 4.
+ */
+inline int utf8_seqlen(unsigned char ch) {
+    if (ch < 0x80) {
+        return 1;
+    }
+    if ((ch & 0xE0) == 0xC0) {
+        return 2;
+    }
+    if ((ch & 0xF0) == 0xE0) {
+        return 3;
+    }
+    if ((ch & 0xF8) == 0xF0) {
+        return 4;
+    }
+    return 1;
+}
+
+/**
+ * @brief Decodes the code point starting at byte offset i.
+ *
+ * Malformed or truncated sequences decode as U+FFFD and consume one byte.
+ *
+ * @param ssText The UTF-8 text.
+ * @param i Offset of the first byte of the sequence; must be in range.
+ * @param cp Receives the code point.
+ * @return The number of bytes consumed.
+ */
+size_t utf8_decode(std::string_view ssText,size_t i,char32_t & cp);
+
+/**
+ * @brief Returns the number of terminal columns a code point occupies.
+ *
+ * Controls, combining marks and other zero-width code points give 0, East
+ * Asian wide and fullwidth characters and wide emoji give 2, everything
+ * else 1.
+ *
+ * @param cp The code point.
+ * @return 0, 1 or 2.
+ */
+int cp_width(char32_t cp);
+
+/**
+ * @brief Returns the number of terminal columns a UTF-8 string occupies.
+ *
+ * Runs of printable ASCII are measured sixteen (SSE2) or eight (portable)
+ * bytes at a time; only the remaining code points go through cp_width().
+ *
+ * @param ssText The UTF-8 text.
+ * @return The display width in columns.
+ */
+int utf8_width(std::string_view ssText);
+
+/**
+ * @brief Finds the longest prefix of UTF-8 text that fits in a number of
+ * columns.
+ *
+ * Zero-width code points that follow the last fitting one stay with it;
+ * a wide glyph that would straddle the limit is left out.
+ *
+ * @param ssText The UTF-8 text.
+ * @param iCols The columns available.
+ * @param iWidth Receives the width of the prefix.
+ * @return The length of the prefix in bytes.
+ */
+size_t utf8_fit(std::string_view ssText,int iCols,int & iWidth);
+
+#endif //UTF8WIDTH_H
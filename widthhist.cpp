@@ -0,0 +1,99 @@
+////////////////////////////////////////////////////////////////////////////////
+// /home/doug/CLionProjects/semigraphics/widthhist.cpp 2026/10/17 16:20 dwg - //
+// Copyright (c) 2021-2026 Douglas Wade Goodall. All Rights Reserved.         //
+////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <bit>
+
+#include "widthhist.h"
+
+/**
+ * @brief Constructs an empty histogram.
+ */
+widthhist::widthhist() {
+    m_iMax = -1;
+    m_iSize = 0;
+}
+
+/**
+ * @brief Counts one more row of the given width.
+ *
+ * The histogram and bitmaps grow to cover the width the first time it
+ * is seen.
+ *
+ * @param iWidth The width.
+ */
+void widthhist::add(int iWidth) {
+    size_t w = std::max(iWidth,0);
+    if (w >= m_counts.size()) {
+        m_counts.resize(w + 1);
+        m_bits.resize(w / 64 + 1);
+        m_summary.resize(w / 4096 + 1);
+    }
+    if (m_counts[w]++ == 0) {
+        m_bits[w / 64] |= uint64_t(1) << (w % 64);
+        m_summary[w / 4096] |= uint64_t(1) << (w / 64 % 64);
+    }
+    m_iMax = std::max(m_iMax,static_cast<int>(w));
+    m_iSize++;
+}
+
+/**
+ * @brief Counts one row of the given width less.
+ *
+ * When the last row of the largest width goes, the next largest is found
+ * from the bitmaps.
+ *
+ * @param iWidth The width; must have been added.
+ */
+void widthhist::remove(int iWidth) {
+    size_t w = std::max(iWidth,0);
+    if (w >= m_counts.size() || m_counts[w] == 0) {
+        return;
+    }
+    m_iSize--;
+    if (--m_counts[w] > 0) {
+        return;
+    }
+    m_bits[w / 64] &= ~(uint64_t(1) << (w % 64));
+    if (m_bits[w / 64] == 0) {
+        m_summary[w / 4096] &= ~(uint64_t(1) << (w / 64 % 64));
+    }
+    if (static_cast<int>(w) == m_iMax) {
+        m_iMax = scan_max();
+    }
+}
+
+/**
+ * @brief Finds the largest width with a non-zero count.
+ *
+ * Walks the summary words from the top; there is one per 4096 widths, so
+ * for any realistic screen this is a single word.
+ *
+ * @return The width, or -1 when empty.
+ */
+int widthhist::scan_max() const {
+    for (size_t k = m_summary.size(); k-- > 0;) {
+        if (m_summary[k] != 0) {
+            size_t j = k * 64 + 63 - std::countl_zero(m_summary[k]);
+            return static_cast<int>(j * 64 + 63 - std::countl_zero(m_bits[j]));
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Removes every width without releasing memory.
+ */
+void widthhist::clear() {
+    std::fill(m_counts.begin(),m_counts.end(),0);
+    std::fill(m_bits.begin(),m_bits.end(),0);
+    std::fill(m_summary.begin(),m_summary.end(),0);
+    m_iMax = -1;
+    m_iSize = 0;
+}
+
+/////////////////////////
+// eof - widthhist.cpp //
+/////////////////////////
@@ -0,0 +1,89 @@
+///////////////////////////////////////////////////////////////////////////////
+// /home/doug/CLionProjects/semigraphics/widthhist.h  2026/10/17 16:20 dwg - //
+// Copyright (c) 2021-2026 Douglas Wade Goodall. All Rights Reserved.        //
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef WIDTHHIST_H
+#define WIDTHHIST_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @class widthhist
+ * @brief A multiset of row widths that answers "widest row" in O(1).
+ *
+ * Widths are counted in a histogram. A bitmap marks the non-empty buckets
+ * and a summary bitmap marks the non-zero bitmap words, so the largest
+ * width is found with two count-leading-zeros steps whatever the number
+ * of rows. Adding and removing a width are O(1) as well.
+ *
+ * Used by window to keep its frame width current when rows are replaced
+ * or erased, without rescanning them.
+ */
+class widthhist {
+    /**
+     * @brief Number of rows of each width.
+     */
+    std::vector<uint32_t> m_counts;
+    /**
+     * @brief Bit w is set when m_counts[w] is non-zero.
+     */
+    std::vector<uint64_t> m_bits;
+    /**
+     * @brief Bit j is set when m_bits[j] is non-zero.
+     */
+    std::vector<uint64_t> m_summary;
+    /**
+     * @brief The largest width held, or -1 when empty.
+     */
+    int m_iMax;
+    /**
+     * @brief Number of widths held.
+     */
+    size_t m_iSize;
+
+    /**
+     * @brief Finds the largest width from the bitmaps.
+     */
+    int scan_max() const;
+
+public:
+    /**
+     * @brief Constructs an empty histogram.
+     */
+    widthhist();
+    /**
+     * @brief Adds one width.
+     *
+     * @param iWidth The width; negative values count as 0.
+     */
+    void add(int iWidth);
+    /**
+     * @brief Removes one width previously added.
+     *
+     * @param iWidth The width.
+     */
+    void remove(int iWidth);
+    /**
+     * @brief Retrieves the largest width held.
+     *
+     * @return The width, or -1 when empty.
+     */
+    int max() const {
+        return m_iMax;
+    }
+    /**
+     * @brief Retrieves the number of widths held.
+     */
+    size_t size() const {
+        return m_iSize;
+    }
+    /**
+     * @brief Removes every width, keeping the allocated capacity.
+     */
+    void clear();
+};
+
+#endif //WIDTHHIST_H
@@ -3,10 +3,16 @@
 // Copyright (c) 2021-2025 Douglas Wade Goodall. All Rights Reserved.       //
 //////////////////////////////////////////////////////////////////////////////
 
-#include "std.h"
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <sstream>
+
 #include "window.h"
 #include "semigraphics.h"
 #include "crtbind.h"
+#include "utf8width.h"
+#include "renderstats.h"
 
 //#include "mwfw2.h"
 
@@ -48,23 +54,201 @@ window::window(
     m_y = 0; // wd.y;
     m_width = 0; // wd.width;
     m_height = 0; // wd.height;
+    m_iScroll = 0;
+    m_iViewport = 0;
+    m_bFollow = true;
+    m_bEndStale = false;
+    m_iMaxRows = 0;
+    m_iDropped = 0;
+    m_bScrollAccel = false;
+    m_bDrawn = false;
+    m_iDrawnTop = 0;
+    m_iDrawnCount = 0;
+    m_iDrawnWidth = 0;
+    m_iVersion = 0;
+    m_memoKey = {};
+    m_drawnKey = {};
+    m_iTitleCols = 0;
+    m_wrap = WRAP_NONE;
+    m_iMaxCols = 0;
+    m_iScrollLine = 0;
 }
 
 /**
  * Adds a new row of text to the window content, dynamically adjusting
- * the window's height and width if needed.
+ * the window's height and width if needed. Widths are display columns
+ * (see utf8_width()), not bytes, and are counted in m_widths so later
+ * edits can shrink the window again.
  *
  * @param ssRow The string representing the content of the row to be added.
  */
-void window::add_row(std::string ssRow) {
-    m_ssData.push_back(ssRow);
+void window::add_row(std::string_view ssRow) {
+    if (renderstats::enabled()) {
+        renderstats::current().iRowsIngested++;
+    }
+    m_rows.append(ssRow);
     m_height++;
-    int iRowSize = ssRow.size() + 3;
-    if (m_width < iRowSize) {
-        m_width = iRowSize;
+    m_iVersion++;
+    m_widths.add(utf8_width(m_rows.row(m_rows.size() - 1)));
+    if (m_iMaxRows > 0 && m_rows.size() > m_iMaxRows) {
+        trim();
+    }
+    fit_width();
+    if (m_bFollow) {
+        m_bEndStale = true;     // resolved once per batch, see settle()
     }
 };
 
+/**
+ * @brief Replaces a row's text and updates the width incrementally.
+ *
+ * @param i Row index; out-of-range indices are ignored.
+ * @param ssRow The new text.
+ */
+void window::update_row(size_t i, std::string_view ssRow) {
+    if (i >= m_rows.size()) {
+        return;
+    }
+    m_widths.remove(utf8_width(m_rows.row(i)));
+    m_reflow.forget(m_iDropped + i);
+    m_rows.update(i,ssRow);
+    m_widths.add(utf8_width(m_rows.row(i)));
+    fit_width();
+    if (m_bFollow) {
+        m_bEndStale = true;     // the row may now wrap to a different number of lines
+    }
+    rows_changed();
+}
+
+/**
+ * @brief Removes a row and updates the width incrementally.
+ *
+ * Rows shown below it move up; a viewport that is not following keeps its
+ * first row in view where possible.
+ *
+ * @param i Row index; out-of-range indices are ignored.
+ */
+void window::erase_row(size_t i) {
+    if (i >= m_rows.size()) {
+        return;
+    }
+    m_widths.remove(utf8_width(m_rows.row(i)));
+    m_rows.erase(i);
+    m_reflow.clear();   // the rows after it are renumbered
+    m_height--;
+    fit_width();
+    if (m_bFollow) {
+        scroll_to_end();
+    } else {
+        scroll_to(m_iScroll - (i < m_iScroll ? 1 : 0));
+    }
+    rows_changed();
+}
+
+/**
+ * @brief Removes every row.
+ *
+ * The width falls back to what the title needs.
+ */
+void window::clear() {
+    m_rows.clear();
+    m_widths.clear();
+    m_reflow.clear();
+    m_height = 0;
+    fit_width();
+    scroll_to_end();
+    rows_changed();
+}
+
+/**
+ * @brief Sets the width to the widest row or the title, whichever is wider.
+ *
+ * Constant time: the widest row comes from m_widths.
+ */
+void window::fit_width() {
+    int iRows = m_widths.max() >= 0 ? m_widths.max() + 3 : 0;
+    m_width = std::max(iRows,m_iTitleCols);
+    if (m_wrap != WRAP_NONE && m_iMaxCols > 0) {
+        m_width = std::min(m_width,std::max(m_iMaxCols + 1,4));
+    }
+    m_reflow.set_cols(m_width - 3);
+}
+
+/**
+ * @brief Sets the wrap mode and re-lays out the viewport.
+ *
+ * @param wrap The mode.
+ */
+void window::set_wrap(WRAP_T wrap) {
+    m_wrap = wrap;
+    fit_width();
+    if (m_bFollow) {
+        scroll_to_end();
+    } else {
+        scroll_to(m_iScroll);
+    }
+    rows_changed();
+}
+
+/**
+ * @brief Sets the column limit and re-lays out the viewport.
+ *
+ * Only the rows brought into view are wrapped again, and of those only the
+ * ones whose breaks move at the new width.
+ *
+ * @param iCols Most frame columns, or 0 for none.
+ */
+void window::set_max_cols(int iCols) {
+    m_iMaxCols = std::max(iCols,0);
+    fit_width();
+    if (m_bFollow) {
+        scroll_to_end();
+    } else {
+        scroll_to(m_iScroll);
+    }
+    rows_changed();
+}
+
+/**
+ * @brief Returns the number of lines row i takes on screen.
+ *
+ * @param i Row index.
+ * @return 1, or the wrapped line count with WRAP_WORD.
+ */
+size_t window::row_lines(size_t i) {
+    if (m_wrap != WRAP_WORD) {
+        return 1;
+    }
+    return m_reflow.lines(m_iDropped + i,m_rows.row(i));
+}
+
+/**
+ * @brief Cuts text that does not fit the text area.
+ *
+ * Display width never exceeds the byte count, so text no longer than the
+ * area in bytes is returned without measuring it.
+ *
+ * @param ssText The text.
+ * @return The part that fits, or ssText unchanged without a column limit.
+ */
+std::string_view window::clip(std::string_view ssText) {
+    size_t iCols = static_cast<size_t>(std::max(m_width - 3,0));
+    if (m_wrap == WRAP_NONE || ssText.size() <= iCols) {
+        return ssText;
+    }
+    int iWidth;
+    return ssText.substr(0,utf8_fit(ssText,static_cast<int>(iCols),iWidth));
+}
+
+/**
+ * @brief Bumps the version and forgets the drawn frame after an edit that
+ * render_scrolled() cannot express as a scroll.
+ */
+void window::rows_changed() {
+    m_iVersion++;
+    m_bDrawn = false;
+}
+
 /**
  * @brief Sets the title of the window and adjusts the width if necessary.
  *
@@ -75,10 +259,225 @@ void window::add_row(std::string ssRow) {
  */
 void window::set_title(std::string ssTitle) {
     m_ssTitle = ssTitle;
-    int iTitleSize = ssTitle.size() + 3;
-    if (m_width < iTitleSize) {
-        m_width = iTitleSize;
+    m_bDrawn = false;
+    m_iVersion++;
+    m_iTitleCols = utf8_width(ssTitle) + 3;
+    fit_width();
+}
+
+/**
+ * @brief Limits the number of content rows drawn by render().
+ *
+ * @param iRows Visible rows, or 0 to show all of them.
+ */
+void window::set_viewport(int iRows) {
+    m_iViewport = std::max(iRows,0);
+    m_bDrawn = false;
+    m_iVersion++;
+    if (m_bFollow) {
+        scroll_to_end();
+    } else {
+        scroll_to(m_iScroll);
+    }
+}
+
+/**
+ * @brief Queues a row from any thread.
+ *
+ * Producers only allocate a queue node and swap it in with one atomic
+ * exchange; the window itself is left alone until drain().
+ *
+ * @param ssRow The row text; copied.
+ */
+void window::post_row(std::string_view ssRow) {
+    m_inbox.push(std::string(ssRow));
+}
+
+/**
+ * @brief Appends rows queued by post_row() in one batch.
+ *
+ * @param iMax Upper bound on the rows moved in this call.
+ * @return The number of rows moved.
+ */
+size_t window::drain(size_t iMax) {
+    size_t iMoved = m_inbox.drain([this](std::string && ssRow) { add_row(ssRow); },iMax);
+    settle();
+    return iMoved;
+}
+
+/**
+ * @brief Bounds the number of rows held.
+ *
+ * @param iRows Maximum number of rows, or 0 for no limit.
+ */
+void window::set_max_rows(size_t iRows) {
+    m_iMaxRows = iRows;
+    if (m_iMaxRows > 0 && m_rows.size() > m_iMaxRows) {
+        trim();
+    }
+}
+
+/**
+ * @brief Drops the oldest rows beyond m_iMaxRows.
+ *
+ * A viewport that is not following keeps showing the same rows until they
+ * are dropped themselves.
+ */
+void window::trim() {
+    size_t iDrop = m_rows.size() - m_iMaxRows;
+    for (size_t i = 0; i < iDrop; i++) {
+        m_widths.remove(utf8_width(m_rows.row(i)));
+    }
+    m_rows.drop_front(iDrop);
+    m_iDropped += iDrop;
+    m_iVersion++;
+    m_height = static_cast<int>(m_rows.size());
+    fit_width();
+    if (m_bFollow) {
+        m_bEndStale = true;
+    } else {
+        if (iDrop > m_iScroll) {
+            m_iScrollLine = 0;
+        }
+        m_iScroll -= std::min(iDrop,m_iScroll);
+    }
+}
+
+/**
+ * @brief Makes the given row the first visible one.
+ *
+ * @param iRow Index of the first visible row; clamped to keep the viewport full.
+ */
+void window::scroll_to(size_t iRow) {
+    size_t iLast;
+    size_t iLastLine;
+    end_position(iLast,iLastLine);
+    if (iRow >= iLast) {
+        m_iScroll = iLast;
+        m_iScrollLine = iLastLine;
+    } else {
+        m_iScroll = iRow;
+        m_iScrollLine = 0;
+    }
+    m_bFollow = m_iScroll == iLast && m_iScrollLine == iLastLine;
+    m_bEndStale = false;
+    m_iVersion++;
+}
+
+/**
+ * @brief Scrolls relative to the current position.
+ *
+ * @param iDelta Rows to move; negative values scroll towards the top.
+ */
+void window::scroll_by(long iDelta) {
+    settle();
+    if (iDelta < 0 && static_cast<size_t>(-iDelta) > m_iScroll) {
+        scroll_to(0);
+        return;
+    }
+    scroll_to(m_iScroll + iDelta);
+}
+
+/**
+ * @brief Pins the viewport to the newest rows.
+ */
+void window::scroll_to_end() {
+    end_position(m_iScroll,m_iScrollLine);
+    m_bFollow = true;
+    m_bEndStale = false;
+    m_iVersion++;
+}
+
+/**
+ * @brief Moves a following viewport to the end after rows changed.
+ *
+ * add_row(), update_row() and trim() only mark the position stale, since
+ * with WRAP_WORD finding the end walks back a viewport's worth of rows;
+ * ingesting a batch then costs one walk instead of one per row. Everything
+ * that reads m_iScroll or m_iScrollLine calls this first.
+ */
+void window::settle() {
+    if (m_bEndStale) {
+        m_bEndStale = false;
+        end_position(m_iScroll,m_iScrollLine);
+    }
+}
+
+/**
+ * @brief Computes where the viewport starts when it shows the last rows.
+ *
+ * Without word wrap that is a viewport's worth of rows from the end. With
+ * it, rows are walked back from the last one until their lines fill the
+ * viewport, so only the rows that end up visible are wrapped; the first
+ * of them may be shown from one of its later lines.
+ *
+ * @param iRow Receives the first visible row.
+ * @param iLine Receives the lines of that row scrolled off the top.
+ */
+void window::end_position(size_t & iRow, size_t & iLine) {
+    size_t iRows = m_rows.size();
+    iLine = 0;
+    if (m_wrap != WRAP_WORD || m_iViewport <= 0) {
+        size_t iPage = m_iViewport > 0 ? static_cast<size_t>(m_iViewport) : iRows;
+        iRow = iRows > iPage ? iRows - iPage : 0;
+        return;
+    }
+    size_t iPage = static_cast<size_t>(m_iViewport);
+    size_t iSum = 0;
+    iRow = iRows;
+    while (iRow > 0 && iSum < iPage) {
+        iSum += row_lines(--iRow);
     }
+    if (iSum > iPage) {
+        iLine = iSum - iPage;
+    }
+}
+
+/**
+ * @brief Enables or disables scrolling the screen in render().
+ *
+ * @param bEnable True to let render() scroll instead of redrawing.
+ */
+void window::set_scroll_accel(bool bEnable) {
+    m_bScrollAccel = bEnable;
+    m_bDrawn = false;
+    m_iVersion++;
+}
+
+/**
+ * @brief Forgets what the last render() drew.
+ */
+void window::invalidate() {
+    m_bDrawn = false;
+}
+
+/**
+ * @brief Retrieves the content version.
+ *
+ * @return A counter bumped by add_row(), set_title(), set_viewport(),
+ * scrolling, trimming and set_scroll_accel().
+ */
+uint64_t window::get_version() {
+    return m_iVersion;
+}
+
+/**
+ * @brief Retrieves the number of content rows.
+ *
+ * @return The row count.
+ */
+size_t window::get_row_count() {
+    return m_rows.size();
+}
+
+/**
+ * @brief Retrieves the index of the first visible row.
+ *
+ * @return The scroll offset.
+ */
+size_t window::get_scroll() {
+    settle();
+    return m_iScroll;
 }
 
 /**
@@ -99,6 +498,47 @@ int window::get_width() {
     return m_width;
 }
 
+/**
+ * @brief Moves the window to a new zero-relative position.
+ *
+ * @param x Column of the left edge.
+ * @param y Line of the top edge.
+ */
+void window::set_position(int x, int y) {
+    m_x = x;
+    m_y = y;
+    m_bDrawn = false;
+}
+
+/**
+ * @brief Retrieves the number of screen lines render() draws: top border,
+ * title, splitter, the visible rows and the bottom border.
+ *
+ * @return The frame height in lines.
+ */
+int window::get_frame_lines() {
+    if (m_iViewport > 0) {
+        return m_iViewport + 4;
+    }
+    settle();
+    size_t iShown = 0;
+    for (size_t i = m_iScroll; i < m_rows.size(); i++) {
+        iShown += row_lines(i);
+    }
+    iShown -= std::min(m_iScrollLine,iShown);
+    return static_cast<int>(iShown) + 4;
+}
+
+/**
+ * @brief Retrieves the number of screen columns render() draws; the border
+ * glyphs sit at the first and last of them.
+ *
+ * @return The frame width in columns.
+ */
+int window::get_frame_cols() {
+    return m_width - 1;
+}
+
 /**
  * Retrieves the zero-based column number of the left corner edge of the window.
  *
@@ -123,24 +563,229 @@ int window::get_y() {
  *
  * This function uses the semigraphics and crtbind modules to create and display
  * a styled terminal-based window. It performs the following:
+ * - Drains rows posted from other threads (see post_row()).
  * - Sets the text style to bold green text on a black background.
  * - Draws the top border of the window.
  * - Draws the window title in the middle of the top section.
  * - Draws a vertical splitter for layout separation.
- * - Iterates through the window's content (m_ssData) to display each row.
+ * - Draws the content rows inside the viewport (see render_rows()).
  * - Draws the bottom border of the window.
  * - Resets the text style to bold cyan text on a black background.
+ *
+ * Each primitive is given the 1-based screen line and column it belongs at,
+ * derived from m_y and m_x. In streaming mode these are ignored; when
+ * gpSemiGr draws into a surface they place the window on the grid.
+ *
+ * With scroll acceleration enabled, a frame whose rows have only moved up
+ * since the last render() is updated by render_scrolled() instead. An
+ * unchanged window replays the bytes of its previous frame (see memoized()).
  */
 void window::render() {
-    gpCrt->crtstyle(MODE_BOLD,FG_GREEN,BG_BLACK);
-    gpSemiGr->topline(1,1,m_width,m_height);
-    gpSemiGr->middleline(1,1,m_width,m_height,m_ssTitle);
-    gpSemiGr->vert_splitter(1,1,m_width,m_height);
-    for (const std::string& str : m_ssData ) {
-        gpSemiGr->middleline(1,1,m_width,m_height,str);
+    renderspan span("window::render",gpSemiGr->get_surface() ? PHASE_LAYOUT : PHASE_BUILD);
+    drain();
+    settle();
+    if (render_scrolled()) {
+        return;
+    }
+    memoized(MEMO_RENDER,&window::draw_window);
+    size_t iCount = m_rows.size() - std::min(m_iScroll,m_rows.size());
+    m_bDrawn = m_bScrollAccel && !gpSemiGr->get_surface();
+    m_iDrawnTop = m_iDropped + m_iScroll;
+    m_iDrawnCount = m_iViewport > 0 ? std::min<size_t>(iCount,m_iViewport) : iCount;
+    m_iDrawnWidth = m_width;
+    if (m_bDrawn) {
+        m_drawnKey = make_key(MEMO_RENDER);
+    }
+}
+
+/**
+ * @brief Moves the cursor to the start of a frame line when the window is
+ * addressed at its position.
+ *
+ * Streamed lines otherwise follow one another from column 1, which is
+ * where the "\n" ending the previous line leaves the cursor. With scroll
+ * acceleration every line is placed at m_x, as render_scrolled() places
+ * the rows it draws; the move is relative and costs nothing when m_x is 0.
+ *
+ * @param iLine The 1-based screen line about to be drawn.
+ */
+void window::address(int iLine) {
+    if (m_bScrollAccel && !gpSemiGr->get_surface()) {
+        gpSemiGr->get_crt()->crtlc(iLine,m_x + 1);
+    }
+}
+
+/**
+ * @brief Draws the title layout at the window's position.
+ *
+ * With scroll acceleration each line starts with a move to the window's
+ * column (see address()), so render_scrolled() can later address its
+ * lines.
+ */
+void window::draw_window() {
+    int iLine = m_y + 1;
+    int iCol = m_x + 1;
+    gpSemiGr->style(MODE_BOLD,FG_GREEN,BG_BLACK);
+    address(iLine);
+    gpSemiGr->topline(iLine++,iCol,m_width,m_height);
+    address(iLine);
+    gpSemiGr->middleline(iLine++,iCol,m_width,m_height,clip(m_ssTitle));
+    address(iLine);
+    gpSemiGr->vert_splitter(iLine++,iCol,m_width,m_height);
+    render_rows(iLine);
+    address(iLine);
+    gpSemiGr->endline(iLine,iCol,m_width,m_height);
+    gpSemiGr->style(MODE_BOLD,FG_CYAN,BG_BLACK);
+}
+
+/**
+ * @brief Draws a layout, replaying the cached bytes when nothing changed.
+ *
+ * Streamed output is encoded by m_pMemo, a side binding matched to the
+ * target and starting from a forgotten style and cursor, and then copied
+ * into the target with crtbind::crtreplay(). Because the bytes do not
+ * depend on the target's state, the next call with the same key (content
+ * version, layout, width, position, theme glyphs, and the target's
+ * capabilities and size) copies them again without drawing anything. The
+ * price is a full SGR at the start of each frame.
+ *
+ * Surface mode draws directly; present() already skips unchanged cells.
+ *
+ * @param iKind MEMO_RENDER or MEMO_FRAMES.
+ * @param pfnDraw The layout to draw on a miss.
+ */
+void window::memoized(int iKind, void (window::*pfnDraw)()) {
+    if (gpSemiGr->get_surface()) {
+        (this->*pfnDraw)();
+        return;
+    }
+    crtbind * pCrt = gpSemiGr->get_crt();
+    memokey key = make_key(iKind);
+    bool bHit = m_pMemo && key.iVersion == m_memoKey.iVersion && key.iKind == m_memoKey.iKind &&
+                key.iWidth == m_memoKey.iWidth && key.x == m_memoKey.x && key.y == m_memoKey.y &&
+                key.uCaps == m_memoKey.uCaps && key.iLines == m_memoKey.iLines &&
+                key.iCols == m_memoKey.iCols && std::memcmp(&key.th,&m_memoKey.th,sizeof(theme)) == 0;
+    if (!bHit) {
+        if (!m_pMemo) {
+            m_pMemo = std::make_unique<crtbind>();
+        }
+        m_pMemo->crtdiscard();
+        m_pMemo->crtmatch(*pCrt);
+        gpSemiGr->set_crt(m_pMemo.get());
+        (this->*pfnDraw)();
+        gpSemiGr->set_crt(pCrt == gpCrt ? nullptr : pCrt);
+        m_memoKey = key;
+    }
+    pCrt->crtreplay(*m_pMemo);
+}
+
+/**
+ * @brief Builds the key a drawing depends on besides the rows.
+ *
+ * @param iKind MEMO_RENDER or MEMO_FRAMES.
+ * @return Content version, layout, width, position, theme glyphs, and the
+ * capabilities and size of the binding gpSemiGr streams to.
+ */
+window::memokey window::make_key(int iKind) {
+    crtbind * pCrt = gpSemiGr->get_crt();
+    return memokey{m_iVersion,iKind,m_width,m_x,m_y,pCrt->crtcaps(),pCrt->crtlines(),pCrt->crtcols(),
+                   *gpSemiGr->get_theme()};
+}
+
+/**
+ * @brief Brings the last frame up to date by scrolling its interior.
+ *
+ * Applies when the viewport, width, title, position and theme are
+ * unchanged, the target binding has the same capabilities and size (the
+ * fields memoized() keys on), and the rows
+ * shown are the ones drawn last time moved up by fewer than a viewport,
+ * possibly followed by rows that fill blank lines below them. The interior
+ * lines are scrolled with crtbind::crtscroll() (not at all when nothing
+ * moved) and only the rows that came into view are drawn; the borders,
+ * title and splitter are left alone. The cursor is left where a full
+ * render would leave it.
+ *
+ * @return True if the frame was updated; false if render() must draw it all.
+ */
+bool window::render_scrolled() {
+    if (!m_bDrawn || !m_bScrollAccel || m_iViewport <= 0 || gpSemiGr->get_surface() ||
+        m_width != m_iDrawnWidth || m_wrap == WRAP_WORD) {
+        return false;
+    }
+    memokey key = make_key(MEMO_RENDER);
+    if (key.x != m_drawnKey.x || key.y != m_drawnKey.y || key.uCaps != m_drawnKey.uCaps ||
+        key.iLines != m_drawnKey.iLines || key.iCols != m_drawnKey.iCols ||
+        std::memcmp(&key.th,&m_drawnKey.th,sizeof(theme)) != 0) {
+        return false;   // the borders kept on screen would not match the rows drawn
+    }
+    size_t iTop = m_iDropped + m_iScroll;
+    size_t iCount = std::min<size_t>(m_rows.size() - std::min(m_iScroll,m_rows.size()),m_iViewport);
+    if (iTop < m_iDrawnTop || iTop + iCount < m_iDrawnTop + m_iDrawnCount) {
+        return false;
+    }
+    size_t iShift = iTop - m_iDrawnTop;
+    if (iShift >= static_cast<size_t>(m_iViewport) || (iShift > 0 && iCount < static_cast<size_t>(m_iViewport))) {
+        return false;   // a full page moved, or lines scrolled in would stay blank
+    }
+    size_t iKeep = m_iDrawnCount - iShift;      // rows still on screen, now from the top
+    int iFirst = m_y + 4;                       // screen line of the first content row
+    crtbind * pCrt = gpSemiGr->get_crt();
+    if (iShift > 0) {
+        pCrt->crtscroll(iFirst,iFirst + m_iViewport - 1,static_cast<int>(iShift));
+    }
+    if (iKeep < iCount) {
+        gpSemiGr->style(MODE_BOLD,FG_GREEN,BG_BLACK);
+        for (size_t i = iKeep; i < iCount; i++) {
+            int iLine = iFirst + static_cast<int>(i);
+            pCrt->crtlc(iLine,m_x + 1);
+            gpSemiGr->middleline(iLine,m_x + 1,m_width,m_height,clip(m_rows.row(m_iScroll + i)));
+        }
+        gpSemiGr->style(MODE_BOLD,FG_CYAN,BG_BLACK);
+    }
+    if (iFirst + m_iViewport + 1 <= pCrt->crtlines()) {
+        pCrt->crtlc(iFirst + m_iViewport + 1,1);   // after the bottom border's "\n"
+    }
+    m_iDrawnTop = iTop;
+    m_iDrawnCount = iCount;
+    return true;
+}
+
+/**
+ * @brief Draws the content rows inside the viewport.
+ *
+ * Only rows from m_iScroll up to the viewport height are touched, so the
+ * cost is independent of how many rows the window holds. When the viewport
+ * is taller than the remaining rows, blank lines keep the frame its size.
+ *
+ * @param iLine The screen line of the first content row; advanced past the
+ * last line drawn.
+ */
+void window::render_rows(int & iLine) {
+    int iCol = m_x + 1;
+    size_t iPage = m_iViewport > 0 ? static_cast<size_t>(m_iViewport) : SIZE_MAX;
+    size_t iShown = 0;
+    if (m_wrap == WRAP_WORD) {
+        for (size_t i = m_iScroll; i < m_rows.size() && iShown < iPage; i++) {
+            uint64_t iId = m_iDropped + i;
+            std::string_view ssRow = m_rows.row(i);
+            int iLines = m_reflow.lines(iId,ssRow);
+            for (int k = i == m_iScroll ? static_cast<int>(m_iScrollLine) : 0; k < iLines && iShown < iPage; k++) {
+                address(iLine);
+                gpSemiGr->middleline(iLine++,iCol,m_width,m_height,m_reflow.segment(iId,ssRow,k));
+                iShown++;
+            }
+        }
+    } else {
+        for (size_t i = m_iScroll; i < m_rows.size() && iShown < iPage; i++) {
+            address(iLine);
+            gpSemiGr->middleline(iLine++,iCol,m_width,m_height,clip(m_rows.row(i)));
+            iShown++;
+        }
+    }
+    for (; m_iViewport > 0 && iShown < iPage; iShown++) {
+        address(iLine);
+        gpSemiGr->middleline(iLine++,iCol,m_width,m_height,"");
     }
-    gpSemiGr->endline(1,1,m_width,m_height);
-    gpCrt->crtstyle(MODE_BOLD,FG_CYAN,BG_BLACK);
 }
 
 /**
@@ -151,7 +796,7 @@ void window::render() {
  * of the frame. The steps include:
  * - Setting the initial text style using a bold green style.
  * - Rendering a top line of the frame based on the window dimensions.
- * - Iterating over the stored textual data (`m_ssData`) to populate the middle lines.
+ * - Drawing the visible content rows (`m_rows`) as the middle lines.
  * - Rendering the bottom line of the frame to complete it.
  * - Resetting the style to a bold cyan configuration.
  *
@@ -160,16 +805,23 @@ void window::render() {
  * are used to size the frame appropriately.
  */
 void window::render_frames() {
-    gpCrt->crtstyle(MODE_BOLD,FG_GREEN,BG_BLACK);
-    gpSemiGr->topline(1,1,m_width,m_height);
-    for (const std::string& str : m_ssData ) {
-        gpSemiGr->middleline(1,1,m_width,m_height,str);
-    }
-    gpSemiGr->endline(1,1,m_width,m_height);
-    gpCrt->crtstyle(MODE_BOLD,FG_CYAN,BG_BLACK);
-
-
+    drain();
+    settle();
+    memoized(MEMO_FRAMES,&window::draw_frames);
+    m_bDrawn = false;
+}
 
+/**
+ * @brief Draws the plain layout: top border, rows and bottom border.
+ */
+void window::draw_frames() {
+    int iLine = m_y + 1;
+    int iCol = m_x + 1;
+    gpSemiGr->style(MODE_BOLD,FG_GREEN,BG_BLACK);
+    gpSemiGr->topline(iLine++,iCol,m_width,m_height);
+    render_rows(iLine);
+    gpSemiGr->endline(iLine,iCol,m_width,m_height);
+    gpSemiGr->style(MODE_BOLD,FG_CYAN,BG_BLACK);
 }
 
 /**
@@ -178,7 +830,7 @@ void window::render_frames() {
  * This method is responsible for outputting the text content stored in the
  * window instance (e.g., the title or any other data associated with its text representation).
  * It takes into account the current state of the window, such as its dimensions
- * and content stored in m_ssData.
+ * and content stored in m_rows.
  *
  * It should ensure the text fits appropriately within the bounds of the window
  * and is displayed in the desired manner.
@@ -188,7 +840,9 @@ void window::render_text() {
 }
 
 /**
- * Displays the properties of the window to the standard output.
+ * Displays the properties of the window through the binding semigraphics
+ * streams to (see semigraphics::get_crt()), so it reaches the same sink
+ * as the frame.
  *
  * This method prints the window's descriptor information, including:
  * - The title of the window, if it is set.
@@ -199,15 +853,17 @@ void window::render_text() {
  * the state of the window object.
  */
 void window::show() {
-    std::cout << "windows descriptor:" << std::endl;
+    std::ostringstream ss;
+    ss << "windows descriptor:" << std::endl;
     if (m_ssTitle.size() > 0) {
-        std::cout << "title: " << m_ssTitle << std::endl;
+        ss << "title: " << m_ssTitle << std::endl;
     }
-    std::cout << "x: " << m_x << std::endl;
-    std::cout << "y: " << m_y << std::endl;
-    std::cout << "width: " << m_width << std::endl;
-    std::cout << "height: " << m_height << std::endl;
-    std::cout << std::endl;
+    ss << "x: " << m_x << std::endl;
+    ss << "y: " << m_y << std::endl;
+    ss << "width: " << m_width << std::endl;
+    ss << "height: " << m_height << std::endl;
+    ss << std::endl;
+    gpSemiGr->get_crt()->crtputs(ss.str());
 }
 
 /**
@@ -217,5 +873,7 @@ void window::show() {
  * Ensures proper cleanup of the window when it goes out of scope.
  */
 window::~window() {
-
+    if (m_pMemo) {
+        m_pMemo->crtdiscard();  // cached bytes are not output
+    }
 }
\ No newline at end of file
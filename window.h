@@ -6,6 +6,19 @@
 #ifndef WINDOW_H
 #define WINDOW_H
 
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "mpscqueue.h"
+#include "rowstore.h"
+#include "semigraphics.h"
+#include "reflow.h"
+#include "widthhist.h"
+
 /**
  * @brief Represents a window descriptor used to manage characteristics and properties of a window.
  *
@@ -104,13 +117,199 @@ class window {
      */
     std::string m_ssTitle;
     /**
-     * @brief Stores a collection of strings that can be used as supplementary or metadata information.
+     * @brief The content rows of the window.
+     *
+     * Rows are packed into one arena with an offset index, so a window with
+     * millions of rows costs roughly their text bytes plus eight bytes each.
+     */
+    rowstore m_rows;
+    /**
+     * @brief Display widths of the rows in m_rows, so that m_width follows
+     * edits and deletions without rescanning.
+     */
+    widthhist m_widths;
+    /**
+     * @brief Columns the title needs (its width plus three), 0 before
+     * set_title().
+     */
+    int m_iTitleCols;
+    /**
+     * @brief How rows wider than the text area are shown.
+     */
+    WRAP_T m_wrap;
+    /**
+     * @brief Most screen columns the frame may take, 0 for no limit; only
+     * applied when m_wrap is not WRAP_NONE.
+     */
+    int m_iMaxCols;
+    /**
+     * @brief Line breaks of wrapped rows, keyed by m_iDropped-based row
+     * number.
+     */
+    reflow m_reflow;
+    /**
+     * @brief Wrapped lines of the row at m_iScroll that are scrolled off the
+     * top (WRAP_WORD only).
+     */
+    size_t m_iScrollLine;
+    /**
+     * @brief Index of the first content row shown by render().
+     */
+    size_t m_iScroll;
+    /**
+     * @brief Maximum number of content rows shown by render(); 0 shows all.
+     */
+    int m_iViewport;
+    /**
+     * @brief True while the viewport is pinned to the last row, so that
+     * add_row() keeps the newest rows in view.
+     */
+    bool m_bFollow;
+    /**
+     * @brief True when rows changed while following and m_iScroll has not
+     * been moved to the end yet; see settle().
+     */
+    bool m_bEndStale;
+    /**
+     * @brief Upper bound on the rows held; the oldest are dropped beyond it.
+     * 0 means unbounded.
+     */
+    size_t m_iMaxRows;
+    /**
+     * @brief Rows posted by other threads and not yet drained into m_rows.
+     */
+    mpscqueue<std::string> m_inbox;
+    /**
+     * @brief Rows dropped from the front by trim() so far; added to an index
+     * into m_rows it gives a row number that does not shift.
+     */
+    size_t m_iDropped;
+    /**
+     * @brief True when render() may scroll the screen instead of redrawing
+     * (see set_scroll_accel()).
+     */
+    bool m_bScrollAccel;
+    /**
+     * @brief True while the terminal shows what the last render() drew.
+     */
+    bool m_bDrawn;
+    /**
+     * @brief Row number (m_iDropped based) of the first row last drawn.
+     */
+    size_t m_iDrawnTop;
+    /**
+     * @brief Number of content rows last drawn.
+     */
+    size_t m_iDrawnCount;
+    /**
+     * @brief Width of the frame last drawn.
+     */
+    int m_iDrawnWidth;
+    /**
+     * @brief Content version; bumped by every mutator that can change what
+     * render() or render_frames() draws.
+     */
+    uint64_t m_iVersion;
+    /**
+     * @brief Side encoder holding the bytes of the last streamed render,
+     * encoded from a forgotten style and cursor; created on first use.
+     */
+    std::unique_ptr<crtbind> m_pMemo;
+    /**
+     * @brief What m_pMemo was encoded from; compared before replaying it.
+     */
+    struct memokey {
+        uint64_t iVersion;
+        int iKind;          // MEMO_RENDER or MEMO_FRAMES
+        int iWidth;
+        int x;
+        int y;
+        unsigned uCaps;
+        int iLines;
+        int iCols;
+        theme th;
+    } m_memoKey;
+    /**
+     * @brief Placement, theme and target settings of the frame last drawn
+     * by render(); render_scrolled() only touches a frame drawn the same way.
+     */
+    memokey m_drawnKey;
+    /**
+     * @brief Layouts kept apart in m_memoKey::iKind.
+     */
+    enum { MEMO_NONE, MEMO_RENDER, MEMO_FRAMES };
+    /**
+     * @brief Draws the content rows that fall inside the viewport.
+     *
+     * @param iLine Screen line of the first row; advanced past the rows drawn.
+     */
+    void render_rows(int & iLine);
+    /**
+     * @brief Updates the previous frame by scrolling it and drawing only the
+     * rows that came into view, when that is possible.
+     *
+     * @return True if the frame is up to date; false if a full render is needed.
+     */
+    bool render_scrolled();
+    /**
+     * @brief Places the cursor at the window's column on a frame line when
+     * scroll acceleration addresses the frame.
+     */
+    void address(int iLine);
+    /**
+     * @brief Draws the title layout: borders, title, splitter and rows.
+     */
+    void draw_window();
+    /**
+     * @brief Draws the plain layout: borders and rows.
+     */
+    void draw_frames();
+    /**
+     * @brief Draws through the memo, replaying the cached bytes when the
+     * window, its placement, the theme and the target binding are unchanged.
+     *
+     * @param iKind MEMO_RENDER or MEMO_FRAMES.
+     * @param pfnDraw The layout to draw on a miss.
+     */
+    void memoized(int iKind,void (window::*pfnDraw)());
+    /**
+     * @brief Builds the memo key for the current content, placement, theme
+     * and target binding.
+     */
+    memokey make_key(int iKind);
+    /**
+     * @brief Drops the oldest rows so that at most m_iMaxRows remain.
+     */
+    void trim();
+    /**
+     * @brief Sets m_width from the widest row and the title.
+     */
+    void fit_width();
+    /**
+     * @brief Notes that held rows changed: bumps the version and makes the
+     * next render() draw everything.
+     */
+    void rows_changed();
+    /**
+     * @brief Number of screen lines a row takes: 1 unless it is word-wrapped.
+     */
+    size_t row_lines(size_t i);
+    /**
+     * @brief Cuts text to the text area when a column limit is in force.
+     */
+    std::string_view clip(std::string_view ssText);
+    /**
+     * @brief Finds the scroll position that shows the last rows in a full
+     * viewport.
      *
-     * The `m_ssData` container is designed to hold string entries, commonly acting as a flexible repository
-     * for additional information or data references. Its specific purpose can vary based on the
-     * implementation context where it is used.
+     * @param iRow Receives the first row.
+     * @param iLine Receives the wrapped lines of that row scrolled off.
+     */
+    void end_position(size_t & iRow,size_t & iLine);
+    /**
+     * @brief Moves a following viewport to the end if rows changed since.
      */
-    std::vector<std::string> m_ssData;
+    void settle();
     /**
      * @brief Represents a window object used as a core element in GUI or display management.
      *
@@ -164,6 +363,28 @@ public:
      * @return The current Y-coordinate as a numerical value.
      */
     int get_y();
+    /**
+     * @brief Moves the window.
+     *
+     * @param x Zero-relative column of the left edge.
+     * @param y Zero-relative line of the top edge.
+     */
+    void set_position(int x,int y);
+    /**
+     * @brief Retrieves the number of screen lines render() draws.
+     *
+     * Title, borders and the rows shown in the viewport; the value changes
+     * as rows arrive unless a viewport is set.
+     *
+     * @return The frame height in lines.
+     */
+    int get_frame_lines();
+    /**
+     * @brief Retrieves the number of screen columns render() draws.
+     *
+     * @return The frame width in columns.
+     */
+    int get_frame_cols();
     /**
      * @brief Adds a new row to the current data structure or collection.
      *
@@ -174,7 +395,141 @@ public:
      * @param row A representation of the row to be added, containing relevant data
      * elements or values that fit within the expected data structure.
      */
-    void add_row(std::string row);
+    void add_row(std::string_view row);
+    /**
+     * @brief Replaces the text of a row.
+     *
+     * The window width follows the change, shrinking when the widest row
+     * gets narrower; the cost does not depend on the number of rows.
+     *
+     * @param i Row index, 0 being the oldest row held.
+     * @param ssRow The new text.
+     */
+    void update_row(size_t i,std::string_view ssRow);
+    /**
+     * @brief Removes a row; the rows after it move up.
+     *
+     * @param i Row index, 0 being the oldest row held.
+     */
+    void erase_row(size_t i);
+    /**
+     * @brief Removes every row; the title stays.
+     */
+    void clear();
+    /**
+     * @brief Limits how many content rows render() draws.
+     *
+     * Rendering cost then depends on the viewport, not on the number of rows
+     * held. The frame is sized to the viewport.
+     *
+     * @param iRows Number of visible rows; 0 (the default) shows every row.
+     */
+    void set_viewport(int iRows);
+    /**
+     * @brief Queues a row from any thread without taking a lock.
+     *
+     * The row becomes part of the window at the next drain(), which render()
+     * performs first. Every other member function, add_row() included,
+     * belongs to the thread that renders the window.
+     *
+     * @param ssRow The row text; copied.
+     */
+    void post_row(std::string_view ssRow);
+    /**
+     * @brief Moves rows queued by post_row() into the window, oldest first.
+     *
+     * @param iMax Upper bound on the rows moved in this call.
+     * @return The number of rows moved.
+     */
+    size_t drain(size_t iMax = SIZE_MAX);
+    /**
+     * @brief Bounds the number of rows held, dropping the oldest beyond it.
+     *
+     * Keeps memory flat when the window is fed from an endless source such
+     * as a followed log file.
+     *
+     * @param iRows Maximum number of rows; 0 (the default) keeps every row.
+     */
+    void set_max_rows(size_t iRows);
+    /**
+     * @brief Chooses how rows wider than the text area are shown.
+     *
+     * With WRAP_TRUNCATE or WRAP_WORD the frame is kept within the column
+     * limit set by set_max_cols(). Word-wrapped rows take several lines;
+     * the viewport then counts lines, and line breaks are computed only
+     * for rows that are shown and cached across resizes (see reflow).
+     *
+     * @param wrap WRAP_NONE (the default), WRAP_TRUNCATE or WRAP_WORD.
+     */
+    void set_wrap(WRAP_T wrap);
+    /**
+     * @brief Limits the screen columns the frame may take.
+     *
+     * Call this when the terminal is resized (see crtbind::crtpoll_resize());
+     * it takes effect with WRAP_TRUNCATE and WRAP_WORD.
+     *
+     * @param iCols Most frame columns, or 0 for no limit.
+     */
+    void set_max_cols(int iCols);
+    /**
+     * @brief Scrolls so that the given row is the first one visible.
+     *
+     * The position is clamped so the viewport stays full where possible.
+     * Scrolling to the end pins the viewport to the newest rows.
+     *
+     * @param iRow Index of the first visible row.
+     */
+    void scroll_to(size_t iRow);
+    /**
+     * @brief Scrolls by a number of rows, negative values moving up.
+     *
+     * @param iDelta Rows to move.
+     */
+    void scroll_by(long iDelta);
+    /**
+     * @brief Pins the viewport to the last rows, following new ones.
+     */
+    void scroll_to_end();
+    /**
+     * @brief Lets render() move rows on screen instead of redrawing them.
+     *
+     * With a viewport set and no surface attached, render() recognises when
+     * the rows shown have only moved up: it scrolls the interior with a
+     * scroll region (see crtbind::crtscroll()) and draws just the new rows.
+     * The window is then addressed at its position, and it must own the
+     * screen lines it occupies, since a scroll region spans whole lines.
+     *
+     * @param bEnable True to enable; off by default.
+     */
+    void set_scroll_accel(bool bEnable);
+    /**
+     * @brief Makes the next render() draw the whole window.
+     *
+     * Call this after anything else has drawn over the window, such as a
+     * screen clear.
+     */
+    void invalidate();
+    /**
+     * @brief Retrieves the content version.
+     *
+     * It changes whenever the window is altered in a way that can change
+     * what it draws, so callers can skip windows that have not.
+     *
+     * @return The version.
+     */
+    uint64_t get_version();
+    /**
+     * @brief Retrieves the number of content rows held.
+     *
+     * @return The row count.
+     */
+    size_t get_row_count();
+    /**
+     * @brief Retrieves the index of the first visible row.
+     *
+     * @return The scroll offset.
+     */
+    size_t get_scroll();
     /**
      * @brief A collection representing frames to be rendered in a graphical context.
      *